@@ -0,0 +1,190 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+static const char PACK_MAGIC[4] = { 'D', 'P', 'A', 'K' };
+
+static const AssetPack* mountedPack = nullptr;
+
+static std::string normalizeName(const std::string& name) {
+    std::string normalized = name;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    if (normalized.compare(0, 2, "./") == 0) normalized.erase(0, 2);
+    return normalized;
+}
+
+static std::uint64_t hashName(const std::string& name) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool AssetPack::open(const char* path) {
+    close();
+    if (!file.open(path)) return false;
+
+    const unsigned char* data = file.data();
+    std::size_t size = file.size();
+    if (size < sizeof(AssetPackHeader)) {
+        close();
+        return false;
+    }
+    header = reinterpret_cast<const AssetPackHeader*>(data);
+    if (std::memcmp(header->magic, PACK_MAGIC, 4) != 0 || header->version != VERSION
+        || size - sizeof(AssetPackHeader) < (std::size_t)header->entryCount * sizeof(AssetPackEntry)) {
+        std::cerr << "Not an asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const AssetPackEntry*>(data + sizeof(AssetPackHeader));
+    std::size_t namesStart = sizeof(AssetPackHeader) + (std::size_t)header->entryCount * sizeof(AssetPackEntry);
+    names = reinterpret_cast<const char*>(data + namesStart);
+    for (std::uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetPackEntry& entry = entries[i];
+        if (entry.offset > size || entry.size >= size - entry.offset
+            || namesStart + entry.nameOffset + entry.nameLength > size) {
+            std::cerr << "Asset pack is truncated: " << path << std::endl;
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    header = nullptr;
+    entries = nullptr;
+    names = nullptr;
+}
+
+bool AssetPack::isOpen() const {
+    return header != nullptr;
+}
+
+bool AssetPack::find(const std::string& name, AssetView& view) const {
+    if (!header) return false;
+
+    std::string normalized = normalizeName(name);
+    std::uint64_t hash = hashName(normalized);
+    const AssetPackEntry* end = entries + header->entryCount;
+    const AssetPackEntry* entry = std::lower_bound(entries, end, hash,
+        [](const AssetPackEntry& candidate, std::uint64_t value) { return candidate.hash < value; });
+    for (; entry != end && entry->hash == hash; ++entry) {
+        if (entry->nameLength == normalized.size() && normalized.compare(0, normalized.size(), names + entry->nameOffset, entry->nameLength) == 0) {
+            view.data = file.data() + entry->offset;
+            view.size = (std::size_t)entry->size;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t AssetPack::getFileCount() const {
+    return header ? header->entryCount : 0;
+}
+
+void AssetPack::mount(const AssetPack* pack) {
+    mountedPack = pack;
+}
+
+bool findAsset(const std::string& path, AssetView& view) {
+    return mountedPack && mountedPack->find(path, view);
+}
+
+bool writeAssetPack(const char* path, const std::vector<std::string>& files) {
+    struct Packed {
+        std::string name;
+        std::vector<char> contents;
+    };
+    std::vector<Packed> packed;
+    for (const std::string& source : files) {
+        std::ifstream in(source, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Missing asset: " << source << std::endl;
+            return false;
+        }
+        Packed file;
+        file.name = normalizeName(source);
+        file.contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        packed.push_back(std::move(file));
+    }
+    std::sort(packed.begin(), packed.end(), [](const Packed& a, const Packed& b) {
+        std::uint64_t hashA = hashName(a.name), hashB = hashName(b.name);
+        return hashA != hashB ? hashA < hashB : a.name < b.name;
+    });
+    for (std::size_t i = 1; i < packed.size(); ++i) {
+        if (packed[i].name == packed[i - 1].name) {
+            std::cerr << "Asset listed twice: " << packed[i].name << std::endl;
+            return false;
+        }
+    }
+
+    AssetPackHeader header = {};
+    std::memcpy(header.magic, PACK_MAGIC, 4);
+    header.version = AssetPack::VERSION;
+    header.entryCount = (std::uint32_t)packed.size();
+
+    std::vector<AssetPackEntry> entries(packed.size());
+    std::string names;
+    for (std::size_t i = 0; i < packed.size(); ++i) {
+        entries[i].hash = hashName(packed[i].name);
+        entries[i].nameOffset = (std::uint32_t)names.size();
+        entries[i].nameLength = (std::uint32_t)packed[i].name.size();
+        names += packed[i].name;
+    }
+    std::uint64_t offset = sizeof(header) + entries.size() * sizeof(AssetPackEntry) + names.size();
+    for (std::size_t i = 0; i < packed.size(); ++i) {
+        offset = (offset + 15) & ~(std::uint64_t)15;
+        entries[i].offset = offset;
+        entries[i].size = packed[i].contents.size();
+        offset += entries[i].size + 1;
+    }
+
+    // Written next to the pack and renamed over it, so a running game never
+    // maps a half-written pack
+    std::string temporary = std::string(path) + ".tmp";
+    bool complete = false;
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Could not write " << path << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AssetPackEntry));
+        out.write(names.data(), names.size());
+        std::uint64_t written = sizeof(header) + entries.size() * sizeof(AssetPackEntry) + names.size();
+        static const char padding[16] = {};
+        for (std::size_t i = 0; i < packed.size(); ++i) {
+            out.write(padding, (std::streamsize)(entries[i].offset - written));
+            out.write(packed[i].contents.data(), packed[i].contents.size());
+            out.write(padding, 1);
+            written = entries[i].offset + entries[i].size + 1;
+        }
+        out.close();
+        complete = !out.fail();
+    }
+    if (!complete) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    // rename does not replace an existing file here; elsewhere it swaps the
+    // new pack in atomically
+    std::remove(path);
+#endif
+    if (std::rename(temporary.c_str(), path) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// All of the game's asset files in one archive (.pak), memory-mapped, so a
+// load is an index lookup and the loaders read straight from the mapping.
+//
+//   header (16 bytes), entryCount entries (32 bytes, sorted by hash), names, data
+//
+// Every file starts 16-byte aligned and is followed by a NUL byte that its
+// size does not count, so text files (shaders) can be used as C strings.
+struct AssetPackHeader {
+    char magic[4];                  // "DPAK"
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+};
+
+struct AssetPackEntry {
+    std::uint64_t hash;             // FNV-1a of the name
+    std::uint64_t offset;           // From the start of the pack
+    std::uint64_t size;             // Bytes, without the NUL
+    std::uint32_t nameOffset;       // From the start of the names
+    std::uint32_t nameLength;
+};
+
+static_assert(sizeof(AssetPackHeader) == 16, "asset pack header must stay 16 bytes");
+static_assert(sizeof(AssetPackEntry) == 32, "asset pack entries must stay 32 bytes");
+
+// A file's bytes inside a pack; valid while the pack is open
+struct AssetView {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+};
+
+class AssetPack {
+public:
+    static const std::uint32_t VERSION = 1;
+
+    bool open(const char* path);    // False if missing, truncated or not a .pak
+    void close();
+    bool isOpen() const;
+
+    // Names are relative paths as they were packed ("basic.vert"); '\\'
+    // and '/' are the same
+    bool find(const std::string& name, AssetView& view) const;
+    std::size_t getFileCount() const;
+
+    // The pack the shader, font and texture loaders look in first (see
+    // findAsset); nullptr: loose files only. Mount before any loader thread
+    // starts and keep the pack open while anything it handed out is in use.
+    static void mount(const AssetPack* pack);
+
+private:
+    MappedFile file;
+    const AssetPackHeader* header = nullptr;
+    const AssetPackEntry* entries = nullptr;
+    const char* names = nullptr;
+};
+
+// The file from the mounted pack; false if none is mounted or it lacks the file
+bool findAsset(const std::string& path, AssetView& view);
+
+// Packing (offline, see tools/PackAssets.cpp). Fails if any file is missing.
+bool writeAssetPack(const char* path, const std::vector<std::string>& files);
+
+#endif // ASSETPACK_H
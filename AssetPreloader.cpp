@@ -0,0 +1,109 @@
+#include "AssetPreloader.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "AssetPack.h"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+AssetPreloader::AssetPreloader() {}
+
+AssetPreloader::~AssetPreloader() {
+    for (auto& task : shaderTasks) task->done.wait();
+    for (auto& task : textureTasks) task->done.wait();
+    for (auto& task : glyphTasks) task->done.wait();
+}
+
+void AssetPreloader::addShaderFiles(const std::vector<std::string>& paths) {
+    ShaderTask* task = new ShaderTask();
+    shaderTasks.emplace_back(task);
+    task->name = "shaders";
+    task->done = std::async(std::launch::async, [task, paths]() {
+        auto start = std::chrono::steady_clock::now();
+        for (const std::string& path : paths) {
+            AssetView packed;
+            if (findAsset(path, packed)) continue;     // ShaderProgram reads it from the pack
+            std::ifstream file(path);
+            if (!file.is_open()) continue;      // Reported when the program is built
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            task->sources[path] = buffer.str();
+        }
+        task->milliseconds = millisecondsSince(start);
+    });
+}
+
+void AssetPreloader::addTexture(const std::string& imagePath) {
+    TextureTask* task = new TextureTask();
+    textureTasks.emplace_back(task);
+    task->name = imagePath;
+    task->done = std::async(std::launch::async, [task]() {
+        auto start = std::chrono::steady_clock::now();
+        task->loaded = prepareTexture(task->name.c_str(), task->texture);
+        task->milliseconds = millisecondsSince(start);
+    });
+}
+
+void AssetPreloader::addGlyphs(const std::string& fontPath, int pixelSize, int spread, std::uint32_t first, std::uint32_t last) {
+    GlyphTask* task = new GlyphTask();
+    glyphTasks.emplace_back(task);
+    task->name = fontPath;
+    task->pixelSize = pixelSize;
+    task->done = std::async(std::launch::async, [task, spread, first, last]() {
+        auto start = std::chrono::steady_clock::now();
+        task->glyphs = rasterizeGlyphs(task->name, task->pixelSize, spread, first, last);
+        task->milliseconds = millisecondsSince(start);
+    });
+}
+
+void AssetPreloader::wait(Task& task) {
+    if (task.done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) return;
+    auto start = std::chrono::steady_clock::now();
+    task.done.wait();
+    waitMilliseconds += millisecondsSince(start);
+}
+
+const std::string* AssetPreloader::getShaderSource(const std::string& path) {
+    for (auto& task : shaderTasks) {
+        wait(*task);
+        auto found = task->sources.find(path);
+        if (found != task->sources.end()) return &found->second;
+    }
+    return nullptr;
+}
+
+PreparedTexture* AssetPreloader::takeTexture(const std::string& imagePath) {
+    for (auto& task : textureTasks) {
+        if (task->name != imagePath || task->taken) continue;
+        wait(*task);
+        task->taken = true;
+        return task->loaded ? &task->texture : nullptr;
+    }
+    return nullptr;
+}
+
+std::vector<GlyphBitmap> AssetPreloader::takeGlyphs(const std::string& fontPath, int pixelSize) {
+    for (auto& task : glyphTasks) {
+        if (task->name != fontPath || task->pixelSize != pixelSize) continue;
+        wait(*task);
+        return std::move(task->glyphs);
+    }
+    return std::vector<GlyphBitmap>();
+}
+
+void AssetPreloader::printTimings() {
+    std::cout << "Preloaded:";
+    const char* separator = " ";
+    auto print = [&](Task& task) {
+        wait(task);
+        std::cout << separator << task.name << " " << task.milliseconds << " ms";
+        separator = ", ";
+    };
+    for (auto& task : shaderTasks) print(*task);
+    for (auto& task : textureTasks) print(*task);
+    for (auto& task : glyphTasks) print(*task);
+    std::cout << " (context thread waited " << waitMilliseconds << " ms)" << std::endl;
+}
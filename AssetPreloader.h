@@ -0,0 +1,69 @@
+#ifndef ASSETPRELOADER_H
+#define ASSETPRELOADER_H
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GlyphRasterizer.h"
+#include "TextureLoader.h"
+
+// Reads the scene's assets on worker threads while the window and GL context
+// are being created: shader sources, textures (prepareTexture) and font
+// glyphs (rasterizeGlyphs). Each add starts a task of its own right away.
+// The context thread then only uploads; every get or take waits for the one
+// task it needs, so the first textures go up while glyphs are still being
+// rendered. Nothing here makes GL calls.
+class AssetPreloader {
+public:
+    AssetPreloader();
+    ~AssetPreloader();      // Waits for unfinished tasks
+
+    void addShaderFiles(const std::vector<std::string>& paths);     // One task for all of them
+    void addTexture(const std::string& imagePath);
+    void addGlyphs(const std::string& fontPath, int pixelSize, int spread, std::uint32_t first, std::uint32_t last);
+
+    // nullptr if the file was not added or could not be read
+    const std::string* getShaderSource(const std::string& path);
+    // nullptr if the image was not added, could not be read or was taken already
+    PreparedTexture* takeTexture(const std::string& imagePath);
+    // Empty if not added (or taken already)
+    std::vector<GlyphBitmap> takeGlyphs(const std::string& fontPath, int pixelSize);
+
+    // Each task's time on its worker, and how long the context thread waited
+    // for them; waits for any still running
+    void printTimings();
+
+private:
+    AssetPreloader(const AssetPreloader&) = delete;
+    AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+    struct Task {
+        std::string name;
+        std::future<void> done;
+        double milliseconds = 0.0;
+    };
+    struct ShaderTask : Task {
+        std::unordered_map<std::string, std::string> sources;
+    };
+    struct TextureTask : Task {
+        PreparedTexture texture;
+        bool loaded = false;
+        bool taken = false;
+    };
+    struct GlyphTask : Task {
+        int pixelSize = 0;
+        std::vector<GlyphBitmap> glyphs;
+    };
+
+    std::vector<std::unique_ptr<ShaderTask>> shaderTasks;
+    std::vector<std::unique_ptr<TextureTask>> textureTasks;
+    std::vector<std::unique_ptr<GlyphTask>> glyphTasks;
+    double waitMilliseconds = 0.0;
+
+    void wait(Task& task);
+};
+
+#endif // ASSETPRELOADER_H
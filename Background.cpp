@@ -1,6 +1,6 @@
 #include "Background.h"
 #include <iostream>
-#include "stb_image.h"
+#include "TextureLoader.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -32,7 +32,7 @@ Background::Background(const std::string& texturePath) {
     glBindVertexArray(0);
 
     // Load the background texture
-    loadTexture(texturePath);
+    textureID = loadTexture(texturePath.c_str());
 
     // Create the shader for rendering the background
     const char* vertexShaderSource = R"(
@@ -40,8 +40,10 @@ Background::Background(const std::string& texturePath) {
         layout(location = 0) in vec3 aPos;
         layout(location = 1) in vec2 aTexCoord;
         out vec2 TexCoord;
-        uniform mat4 projection;
-        uniform mat4 view;
+        layout(std140) uniform Camera {
+            mat4 projection;
+            mat4 view;
+        };
         void main() {
             gl_Position = projection * view * vec4(aPos, 1.0);
             TexCoord = aTexCoord;
@@ -58,20 +60,10 @@ Background::Background(const std::string& texturePath) {
         }
     )";
 
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    shader.loadSource(vertexShaderSource, fragmentShaderSource);
+    shader.use();
+    glUniform1i(shader.getUniformLocation("texture1"), 0);
+    glUseProgram(0);
 }
 
 // Destructor
@@ -79,43 +71,13 @@ Background::~Background() {
     glDeleteTextures(1, &textureID);
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
-    glDeleteProgram(shaderProgram);
-}
-
-// Load texture from file using stb_image
-void Background::loadTexture(const std::string& texturePath) {
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(texturePath.c_str(), &width, &height, &nrChannels, 0);
-    if (!data) {
-        std::cout << "Failed to load texture!" << std::endl;
-        return;
-    }
-
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    stbi_image_free(data);
 }
 
 // Render the background
-void Background::render(const glm::mat4& projection, const glm::mat4& view) {
-    glUseProgram(shaderProgram);
+void Background::render() {
+    shader.use();
     glBindVertexArray(VAO);
 
-    // Set the projection and view matrices
-    unsigned int projectionLoc = glGetUniformLocation(shaderProgram, "projection");
-    unsigned int viewLoc = glGetUniformLocation(shaderProgram, "view");
-
-    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textureID);
 
@@ -2,15 +2,16 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <string>
+#include "ShaderProgram.h"
 
 class Background {
 public:
     Background(const std::string& texturePath); // Constructor with the texture path
     ~Background();
-    void render(const glm::mat4& projection, const glm::mat4& view); // Render the background with projection and view matrices
+    void render(); // Render the background with the camera from SceneUniforms
 
 private:
-    GLuint VAO, VBO, textureID, shaderProgram; // OpenGL objects
-    void loadTexture(const std::string& texturePath); // Load texture from file
+    GLuint VAO, VBO, textureID; // OpenGL objects
+    ShaderProgram shader;
 };
 
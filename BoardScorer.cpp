@@ -0,0 +1,264 @@
+#include "BoardScorer.h"
+#include <cmath>
+
+// The batch kernels must match score() bit for bit, so the compiler may not
+// fuse x * x + y * y into an FMA in one path and keep it separate in another.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BOARDSCORER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BOARDSCORER_TARGET(isa)
+#else
+#define BOARDSCORER_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+const BoardRings& BoardScorer::getRings() const {
+    return BoardSpec::RINGS;
+}
+
+const BoardRings& BoardScorer::getRingsSquared() const {
+    return BoardSpec::RINGS_SQUARED;
+}
+
+int BoardScorer::sectorAt(float x, float y) const {
+    // Sectors 10-19 are sectors 0-9 mirrored through the origin
+    bool mirrored = BoardSpec::BOUNDARIES.cos[0] * y < BoardSpec::BOUNDARIES.sin[0] * x;
+    if (mirrored) {
+        x = -x;
+        y = -y;
+    }
+
+    // Count the boundaries the point lies counter-clockwise of (sign of the cross product)
+    int sector = mirrored ? 10 : 0;
+    for (int k = 1; k < 10; ++k) {
+        if (BoardSpec::BOUNDARIES.cos[k] * y >= BoardSpec::BOUNDARIES.sin[k] * x) sector++;
+    }
+    return sector;
+}
+
+int BoardScorer::score(float x, float y) const {
+    return segment(x, y).score();
+}
+
+BoardSegment BoardScorer::segment(float x, float y) const {
+    float radiusSquared = x * x + y * y;
+
+    // Score zones
+    if (radiusSquared <= BoardSpec::RINGS_SQUARED.bullseyeInner) return { 25, 2 };  // Bullseye (inner red circle)
+    if (radiusSquared <= BoardSpec::RINGS_SQUARED.bullseyeOuter) return { 25, 1 };  // Outer bullseye (green circle)
+    if (radiusSquared > BoardSpec::RINGS_SQUARED.outer) return { 0, 0 };            // Outside the dartboard
+
+    int value = BoardSpec::SECTORS[sectorAt(x, y)];
+
+    // Check double and triple rings
+    if (radiusSquared > BoardSpec::RINGS_SQUARED.doubleInner && radiusSquared <= BoardSpec::RINGS_SQUARED.doubleOuter) return { value, 2 };
+    if (radiusSquared > BoardSpec::RINGS_SQUARED.tripleInner && radiusSquared <= BoardSpec::RINGS_SQUARED.tripleOuter) return { value, 3 };
+
+    // Regular scoring
+    return { value, 1 };
+}
+
+void BoardScorer::aimPoint(const BoardSegment& target, float& x, float& y) const {
+    const BoardRings& rings = BoardSpec::RINGS;
+    x = 0.0f;
+    y = 0.0f;
+    if (target.number == 25) {
+        if (target.multiplier == 1) y = 0.5f * (rings.bullseyeInner + rings.bullseyeOuter);
+        return;
+    }
+
+    int sector = 0;
+    while (sector < 20 && BoardSpec::SECTORS[sector] != target.number) ++sector;
+    if (sector == 20) return;
+
+    float radius = 0.5f * (rings.tripleOuter + rings.doubleInner);
+    if (target.multiplier == 2) radius = 0.5f * (rings.doubleInner + rings.doubleOuter);
+    if (target.multiplier == 3) radius = 0.5f * (rings.tripleInner + rings.tripleOuter);
+
+    double radians = (BoardSpec::FIRST_BOUNDARY_DEGREES + BoardSpec::SECTOR_DEGREES * (sector + 0.5)) * BoardSpec::PI / 180.0;
+    x = radius * (float)std::cos(radians);
+    y = radius * (float)std::sin(radians);
+}
+
+enum BatchKernel { KERNEL_SCALAR, KERNEL_SSE41, KERNEL_AVX2 };
+
+static BatchKernel detectBatchKernel() {
+#if defined(BOARDSCORER_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    if (avx2) return KERNEL_AVX2;
+    if (sse41) return KERNEL_SSE41;
+#elif defined(BOARDSCORER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return KERNEL_SSE41;
+#endif
+    return KERNEL_SCALAR;
+}
+
+static BatchKernel batchKernel() {
+    static const BatchKernel kernel = detectBatchKernel();
+    return kernel;
+}
+
+const char* BoardScorer::getBatchKernelName() {
+    switch (batchKernel()) {
+    case KERNEL_AVX2: return "avx2";
+    case KERNEL_SSE41: return "sse4.1";
+    default: return "scalar";
+    }
+}
+
+void BoardScorer::scoreBatch(const float* xs, const float* ys, int* scores, std::size_t count) const {
+    switch (batchKernel()) {
+    case KERNEL_AVX2: scoreBatchAvx2(xs, ys, scores, count); break;
+    case KERNEL_SSE41: scoreBatchSse41(xs, ys, scores, count); break;
+    default: scoreBatchScalar(xs, ys, scores, count); break;
+    }
+}
+
+void BoardScorer::scoreBatchScalar(const float* xs, const float* ys, int* scores, std::size_t count) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        scores[i] = score(xs[i], ys[i]);
+    }
+}
+
+#if defined(BOARDSCORER_X86)
+
+BOARDSCORER_TARGET("sse4.1")
+void BoardScorer::scoreBatchSse41(const float* xs, const float* ys, int* scores, std::size_t count) const {
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 cos0 = _mm_set1_ps(BoardSpec::BOUNDARIES.cos[0]);
+    const __m128 sin0 = _mm_set1_ps(BoardSpec::BOUNDARIES.sin[0]);
+    const __m128 bullInner = _mm_set1_ps(BoardSpec::RINGS_SQUARED.bullseyeInner);
+    const __m128 bullOuter = _mm_set1_ps(BoardSpec::RINGS_SQUARED.bullseyeOuter);
+    const __m128 outer = _mm_set1_ps(BoardSpec::RINGS_SQUARED.outer);
+    const __m128 doubleInner = _mm_set1_ps(BoardSpec::RINGS_SQUARED.doubleInner);
+    const __m128 doubleOuter = _mm_set1_ps(BoardSpec::RINGS_SQUARED.doubleOuter);
+    const __m128 tripleInner = _mm_set1_ps(BoardSpec::RINGS_SQUARED.tripleInner);
+    const __m128 tripleOuter = _mm_set1_ps(BoardSpec::RINGS_SQUARED.tripleOuter);
+
+    // BoardSpec::SECTORS as bytes for two 16-entry pshufb lookups
+    const __m128i valuesLow = _mm_setr_epi8(20, 5, 12, 9, 14, 11, 8, 16, 7, 19, 3, 17, 2, 15, 10, 6);
+    const __m128i valuesHigh = _mm_setr_epi8(13, 4, 18, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i zeroUpperBytes = _mm_set1_epi32((int)0x80808000);
+    const __m128i noLookup = _mm_set1_epi32(0x80);
+    const __m128i fifteen = _mm_set1_epi32(15);
+    const __m128i sixteen = _mm_set1_epi32(16);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 radiusSquared = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+
+        __m128 mirrored = _mm_cmplt_ps(_mm_mul_ps(cos0, y), _mm_mul_ps(sin0, x));
+        __m128 flip = _mm_and_ps(mirrored, signBit);
+        x = _mm_xor_ps(x, flip);
+        y = _mm_xor_ps(y, flip);
+
+        __m128i sector = _mm_and_si128(_mm_castps_si128(mirrored), _mm_set1_epi32(10));
+        for (int k = 1; k < 10; ++k) {
+            __m128 ccw = _mm_cmpge_ps(_mm_mul_ps(_mm_set1_ps(BoardSpec::BOUNDARIES.cos[k]), y), _mm_mul_ps(_mm_set1_ps(BoardSpec::BOUNDARIES.sin[k]), x));
+            sector = _mm_sub_epi32(sector, _mm_castps_si128(ccw));
+        }
+
+        __m128i high = _mm_cmpgt_epi32(sector, fifteen);
+        __m128i lowIndex = _mm_or_si128(_mm_blendv_epi8(sector, noLookup, high), zeroUpperBytes);
+        __m128i highIndex = _mm_or_si128(_mm_blendv_epi8(noLookup, _mm_sub_epi32(sector, sixteen), high), zeroUpperBytes);
+        __m128i value = _mm_or_si128(_mm_shuffle_epi8(valuesLow, lowIndex), _mm_shuffle_epi8(valuesHigh, highIndex));
+
+        __m128 inTriple = _mm_and_ps(_mm_cmpgt_ps(radiusSquared, tripleInner), _mm_cmple_ps(radiusSquared, tripleOuter));
+        __m128 inDouble = _mm_and_ps(_mm_cmpgt_ps(radiusSquared, doubleInner), _mm_cmple_ps(radiusSquared, doubleOuter));
+        __m128i multiplier = _mm_set1_epi32(1);
+        multiplier = _mm_blendv_epi8(multiplier, _mm_set1_epi32(3), _mm_castps_si128(inTriple));
+        multiplier = _mm_blendv_epi8(multiplier, _mm_set1_epi32(2), _mm_castps_si128(inDouble));
+
+        __m128i result = _mm_mullo_epi32(value, multiplier);
+        result = _mm_andnot_si128(_mm_castps_si128(_mm_cmpgt_ps(radiusSquared, outer)), result);
+        result = _mm_blendv_epi8(result, _mm_set1_epi32(25), _mm_castps_si128(_mm_cmple_ps(radiusSquared, bullOuter)));
+        result = _mm_blendv_epi8(result, _mm_set1_epi32(50), _mm_castps_si128(_mm_cmple_ps(radiusSquared, bullInner)));
+        _mm_storeu_si128((__m128i*)(scores + i), result);
+    }
+
+    scoreBatchScalar(xs + i, ys + i, scores + i, count - i);
+}
+
+BOARDSCORER_TARGET("avx2")
+void BoardScorer::scoreBatchAvx2(const float* xs, const float* ys, int* scores, std::size_t count) const {
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 cos0 = _mm256_set1_ps(BoardSpec::BOUNDARIES.cos[0]);
+    const __m256 sin0 = _mm256_set1_ps(BoardSpec::BOUNDARIES.sin[0]);
+    const __m256 bullInner = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.bullseyeInner);
+    const __m256 bullOuter = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.bullseyeOuter);
+    const __m256 outer = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.outer);
+    const __m256 doubleInner = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.doubleInner);
+    const __m256 doubleOuter = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.doubleOuter);
+    const __m256 tripleInner = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.tripleInner);
+    const __m256 tripleOuter = _mm256_set1_ps(BoardSpec::RINGS_SQUARED.tripleOuter);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = _mm256_loadu_ps(ys + i);
+        __m256 radiusSquared = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+
+        __m256 mirrored = _mm256_cmp_ps(_mm256_mul_ps(cos0, y), _mm256_mul_ps(sin0, x), _CMP_LT_OQ);
+        __m256 flip = _mm256_and_ps(mirrored, signBit);
+        x = _mm256_xor_ps(x, flip);
+        y = _mm256_xor_ps(y, flip);
+
+        __m256i sector = _mm256_and_si256(_mm256_castps_si256(mirrored), _mm256_set1_epi32(10));
+        for (int k = 1; k < 10; ++k) {
+            __m256 ccw = _mm256_cmp_ps(_mm256_mul_ps(_mm256_set1_ps(BoardSpec::BOUNDARIES.cos[k]), y), _mm256_mul_ps(_mm256_set1_ps(BoardSpec::BOUNDARIES.sin[k]), x), _CMP_GE_OQ);
+            sector = _mm256_sub_epi32(sector, _mm256_castps_si256(ccw));
+        }
+
+        __m256i value = _mm256_i32gather_epi32(BoardSpec::SECTORS, sector, 4);
+
+        __m256 inTriple = _mm256_and_ps(_mm256_cmp_ps(radiusSquared, tripleInner, _CMP_GT_OQ), _mm256_cmp_ps(radiusSquared, tripleOuter, _CMP_LE_OQ));
+        __m256 inDouble = _mm256_and_ps(_mm256_cmp_ps(radiusSquared, doubleInner, _CMP_GT_OQ), _mm256_cmp_ps(radiusSquared, doubleOuter, _CMP_LE_OQ));
+        __m256i multiplier = _mm256_set1_epi32(1);
+        multiplier = _mm256_blendv_epi8(multiplier, _mm256_set1_epi32(3), _mm256_castps_si256(inTriple));
+        multiplier = _mm256_blendv_epi8(multiplier, _mm256_set1_epi32(2), _mm256_castps_si256(inDouble));
+
+        __m256i result = _mm256_mullo_epi32(value, multiplier);
+        result = _mm256_andnot_si256(_mm256_castps_si256(_mm256_cmp_ps(radiusSquared, outer, _CMP_GT_OQ)), result);
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(25), _mm256_castps_si256(_mm256_cmp_ps(radiusSquared, bullOuter, _CMP_LE_OQ)));
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(50), _mm256_castps_si256(_mm256_cmp_ps(radiusSquared, bullInner, _CMP_LE_OQ)));
+        _mm256_storeu_si256((__m256i*)(scores + i), result);
+    }
+
+    scoreBatchScalar(xs + i, ys + i, scores + i, count - i);
+}
+
+#else
+
+// No SIMD kernels off x86; the dispatcher never selects these
+void BoardScorer::scoreBatchSse41(const float* xs, const float* ys, int* scores, std::size_t count) const {
+    scoreBatchScalar(xs, ys, scores, count);
+}
+
+void BoardScorer::scoreBatchAvx2(const float* xs, const float* ys, int* scores, std::size_t count) const {
+    scoreBatchScalar(xs, ys, scores, count);
+}
+
+#endif
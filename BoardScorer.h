@@ -0,0 +1,46 @@
+#ifndef BOARDSCORER_H
+#define BOARDSCORER_H
+
+#include <cstddef>
+#include "BoardSpec.h"
+
+// Where a dart landed: the number hit (1-20, 25 for the bull, 0 for a miss)
+// and its multiplier (1-3; the inner bull is a double 25)
+struct BoardSegment {
+    int number;
+    int multiplier;
+
+    int score() const { return number * multiplier; }
+};
+
+// Scoring against the compile-time BoardSpec geometry, kept free of any
+// GL/GLFW dependency so throws can be scored without a window (analytics,
+// replays, simulations). Only the board-space position matters.
+class BoardScorer {
+public:
+
+    int score(float x, float y) const;   // Score a single throw
+    BoardSegment segment(float x, float y) const; // Segment a single throw landed in
+
+    // Score count throws given as separate x and y arrays (structure of arrays).
+    // Uses the widest SIMD kernel the CPU supports; results are identical to score().
+    void scoreBatch(const float* xs, const float* ys, int* scores, std::size_t count) const;
+
+    // Middle of a segment, where a player aims to hit it. Singles aim at the
+    // wide outer single area; a miss aims at the centre.
+    void aimPoint(const BoardSegment& target, float& x, float& y) const;
+
+    const BoardRings& getRings() const;
+    const BoardRings& getRingsSquared() const; // Exact thresholds used by score()
+
+    static const char* getBatchKernelName(); // "avx2", "sse4.1" or "scalar"
+
+private:
+    int sectorAt(float x, float y) const;
+
+    void scoreBatchScalar(const float* xs, const float* ys, int* scores, std::size_t count) const;
+    void scoreBatchSse41(const float* xs, const float* ys, int* scores, std::size_t count) const;
+    void scoreBatchAvx2(const float* xs, const float* ys, int* scores, std::size_t count) const;
+};
+
+#endif // BOARDSCORER_H
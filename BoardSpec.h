@@ -0,0 +1,95 @@
+#ifndef BOARDSPEC_H
+#define BOARDSPEC_H
+
+// Board dimensions, fixed at compile time. Everything is in board space, the
+// plane the dartboard quad is drawn in, so a point scores the same no matter
+// how far the camera is zoomed.
+
+// Radii of the scoring rings (same units as Dartboard::RADIUS)
+struct BoardRings {
+    float bullseyeInner;
+    float bullseyeOuter;
+    float tripleInner;
+    float tripleOuter;
+    float doubleInner;
+    float doubleOuter;
+    float outer;
+};
+
+// Directions of the first ten sector boundaries; the other ten are the same
+// lines mirrored through the centre
+struct SectorBoundaries {
+    float cos[10];
+    float sin[10];
+};
+
+namespace BoardSpec {
+    constexpr double PI = 3.14159265358979323846;
+
+    constexpr float RADIUS = 0.4f;              // Radius of the textured board (Dartboard::RADIUS)
+
+    // Regulation ring radii in millimetres, scaled so the outer double wire
+    // lands where Dartboard.png draws it (74.25% of the textured radius)
+    constexpr float PLAYING_RADIUS = RADIUS * 0.7425f;
+    constexpr float MILLIMETRE = PLAYING_RADIUS / 170.0f;
+
+    constexpr BoardRings RINGS = {
+        6.35f * MILLIMETRE,     // Bullseye
+        15.9f * MILLIMETRE,     // Outer bull
+        99.0f * MILLIMETRE,     // Triple ring
+        107.0f * MILLIMETRE,
+        162.0f * MILLIMETRE,    // Double ring
+        170.0f * MILLIMETRE,
+        170.0f * MILLIMETRE     // Nothing scores past the double ring
+    };
+
+    // Thresholds compared against x*x + y*y
+    constexpr BoardRings RINGS_SQUARED = {
+        RINGS.bullseyeInner * RINGS.bullseyeInner,
+        RINGS.bullseyeOuter * RINGS.bullseyeOuter,
+        RINGS.tripleInner * RINGS.tripleInner,
+        RINGS.tripleOuter * RINGS.tripleOuter,
+        RINGS.doubleInner * RINGS.doubleInner,
+        RINGS.doubleOuter * RINGS.doubleOuter,
+        RINGS.outer * RINGS.outer
+    };
+
+    // Sector values, counter-clockwise from the 20
+    constexpr int SECTORS[20] = { 20, 5, 12, 9, 14, 11, 8, 16, 7, 19, 3, 17, 2, 15, 10, 6, 13, 4, 18, 1 };
+
+    constexpr double FIRST_BOUNDARY_DEGREES = 80.0;  // Where the 20 starts, from the +x axis
+    constexpr double SECTOR_DEGREES = 18.0;
+
+    // Taylor series for sine, evaluated by the compiler
+    constexpr double sine(double radians) {
+        while (radians > PI) radians -= 2.0 * PI;
+        while (radians < -PI) radians += 2.0 * PI;
+        double term = radians;
+        double sum = radians;
+        for (int n = 1; n < 15; ++n) {
+            term *= -radians * radians / ((2.0 * n) * (2.0 * n + 1.0));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr SectorBoundaries makeBoundaries() {
+        SectorBoundaries boundaries = {};
+        for (int k = 0; k < 10; ++k) {
+            double radians = (FIRST_BOUNDARY_DEGREES + SECTOR_DEGREES * k) * PI / 180.0;
+            boundaries.cos[k] = (float)sine(radians + PI / 2.0);
+            boundaries.sin[k] = (float)sine(radians);
+        }
+        return boundaries;
+    }
+
+    constexpr SectorBoundaries BOUNDARIES = makeBoundaries();
+
+    static_assert(RINGS.bullseyeInner < RINGS.bullseyeOuter && RINGS.bullseyeOuter < RINGS.tripleInner,
+        "bull must sit inside the triple ring");
+    static_assert(RINGS.tripleOuter < RINGS.doubleInner && RINGS.doubleOuter <= RINGS.outer,
+        "triple ring must sit inside the double ring");
+    static_assert(RINGS.outer < RADIUS, "scoring area must fit on the textured board");
+}
+
+#endif // BOARDSPEC_H
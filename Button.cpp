@@ -1,15 +1,14 @@
 #include "Button.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 
 Button::Button(float x, float y, float width, float height)
-    : x(x), y(y), width(width), height(height), shaderProgram(0), VAO(0), VBO(0), EBO(0) {
+    : x(x), y(y), width(width), height(height), VAO(0), VBO(0), EBO(0) {
     // Initialize shader for a color button (no texture)
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    shaderProgram = createShader("button.vert", "button.frag");
+    shader.loadFiles("button.vert", "button.frag");
+    colorLoc = shader.getUniformLocation("buttonColor");
     setupButtonGeometry(); // Initialize geometry for the button
 }
 
@@ -28,15 +27,6 @@ Button::~Button() {
         std::cout << "Deleting VAO..." << std::endl;
         glDeleteVertexArrays(1, &VAO);
     }
-    if (shaderProgram != 0) {
-        std::cout << "Deleting shader program..." << std::endl;
-        glDeleteProgram(shaderProgram);
-    }
-}
-
-// Set the shader program for the button
-void Button::setShader(unsigned int shaderProgram) {
-    this->shaderProgram = shaderProgram;
 }
 
 // Set up the geometry for the button
@@ -73,67 +63,12 @@ void Button::setupButtonGeometry() {
     glBindVertexArray(0);
 }
 
-// Helper to compile shader
-unsigned int Button::compileShader(GLenum type, const char* sourcePath) {
-    std::ifstream file(sourcePath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open shader file: " << sourcePath << std::endl;
-        return 0;
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string sourceCode = buffer.str();
-    const char* source = sourceCode.c_str();
-
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Error compiling shader: " << infoLog << std::endl;
-        glDeleteShader(shader);
-        return 0;
-    }
-
-    return shader;
-}
-
-// Create a shader program using vertex and fragment shaders
-unsigned int Button::createShader(const char* vertexShaderPath, const char* fragmentShaderPath) {
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderPath);
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderPath);
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    char infoLog[512];
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        std::cerr << "Error linking shader program: " << infoLog << std::endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return program;
-}
-
 // Render the button
 void Button::render() {
     // Use the shader program
-    glUseProgram(shaderProgram);
+    shader.use();
 
     // Set the button color (using a uniform color for the button)
-    GLint colorLoc = glGetUniformLocation(shaderProgram, "buttonColor");
     if (colorLoc != -1) {
         glUniform3f(colorLoc, 0.0f, 1.0f, 0.0f); // Green color (can be changed)
     }
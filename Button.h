@@ -3,6 +3,7 @@
 
 #include <GL/glew.h>
 #include <string>
+#include "ShaderProgram.h"
 
 class Button {
 public:
@@ -10,21 +11,15 @@ public:
     ~Button();
 
     void render();
-    void setShader(unsigned int shaderProgram);
 
 private:
     float x, y, width, height;
-    unsigned int shaderProgram; // Shader program for the button
+    ShaderProgram shader;       // Shader program for the button
+    GLint colorLoc = -1;
     unsigned int VAO, VBO, EBO;       // OpenGL objects for button rendering
 
     // Setup geometry for button rendering
     void setupButtonGeometry();
-
-    // Compile shader from source file
-    unsigned int compileShader(GLenum type, const char* sourcePath);
-
-    // Create shader program using vertex and fragment shaders
-    unsigned int createShader(const char* vertexShaderPath, const char* fragmentShaderPath);
 };
 
 #endif // BUTTON_H
@@ -0,0 +1,199 @@
+#include "CheckoutTable.h"
+#include "Random.h"
+#include "ScoreGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const char MAGIC[4] = { 'D', 'C', 'K', 'T' };
+
+// Segment codes 1-62 are the aim targets (code 0, a miss, is never aimed at)
+static const int TARGET_COUNT = ScoreGrid::SEGMENT_CODES - 1;
+
+struct Outcome {
+    BoardSegment segment;
+    double probability;
+};
+
+CheckoutTable::CheckoutTable() : header(), entries(nullptr) {
+}
+
+CheckoutTable::Header CheckoutTable::makeHeader(const X01Rules& rules, float sigma) {
+    Header result = {};
+    std::memcpy(result.magic, MAGIC, sizeof(MAGIC));
+    result.version = VERSION;
+    result.flags = rules.doubleOut ? 1u : 0u;
+    result.startScore = (std::uint32_t)rules.startScore;
+    result.sigma = sigma;
+    result.entryCount = ENTRY_COUNT;
+    return result;
+}
+
+void CheckoutTable::build(const X01Rules& rules, float sigma, int samplesPerTarget, std::uint64_t seed) {
+    BoardScorer scorer;
+    ScoreGrid grid(scorer);
+
+    // Where darts land when aimed at each target, sampled once up front
+    std::vector<std::vector<Outcome>> outcomes(TARGET_COUNT);
+    Random generator(seed);
+    std::vector<float> offsets(2 * (std::size_t)samplesPerTarget);
+    std::vector<int> counts(ScoreGrid::SEGMENT_CODES);
+    for (int target = 0; target < TARGET_COUNT; ++target) {
+        float aimX, aimY;
+        scorer.aimPoint(ScoreGrid::decode((unsigned char)(target + 1)), aimX, aimY);
+
+        std::fill(counts.begin(), counts.end(), 0);
+        generator.fillGaussians(offsets.data(), offsets.size(), sigma);
+        for (int sample = 0; sample < samplesPerTarget; ++sample) {
+            float x = aimX + offsets[2 * sample];
+            float y = aimY + offsets[2 * sample + 1];
+            ++counts[ScoreGrid::encode(grid.segment(x, y))];
+        }
+        for (int code = 0; code < ScoreGrid::SEGMENT_CODES; ++code) {
+            if (counts[code] == 0) continue;
+            outcomes[target].push_back({ ScoreGrid::decode((unsigned char)code), (double)counts[code] / samplesPerTarget });
+        }
+    }
+
+    // Solved one turn-start score at a time, lowest first. Within a turn the
+    // score only goes down, and a turn that ends lower lands on an already
+    // solved score. A turn that ends where it started (misses, ignored darts,
+    // busts) comes back to the unknown being solved, so treat that value as x
+    // and run Newton's method on x = f(x), tracking df/dx alongside each value.
+    // f is a minimum of linear functions, so starting above the answer every
+    // step lands above it too and never picks a policy that cannot progress.
+    std::vector<double> solved(MAX_SCORE + 1, 0.0);
+    std::vector<double> expected(ENTRY_COUNT, 0.0);
+    std::vector<unsigned char> bestTargets(ENTRY_COUNT, 0);
+    std::vector<double> slope(ENTRIES_PER_TURN);
+    for (int turnStart = rules.minimumCheckout(); turnStart <= MAX_SCORE; ++turnStart) {
+        double* value = &expected[(std::size_t)turnStart * ENTRIES_PER_TURN];
+        unsigned char* targets = &bestTargets[(std::size_t)turnStart * ENTRIES_PER_TURN];
+        double x = 10000.0;
+
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            for (int dartsLeft = 1; dartsLeft <= 3; ++dartsLeft) {
+                for (int scored = 0; scored <= 60 * (3 - dartsLeft); ++scored) {
+                    int remaining = turnStart - scored;
+                    int offset = turnOffset(dartsLeft, scored);
+                    if (remaining < rules.minimumCheckout()) continue;
+
+                    double best = HUGE_VAL, bestSlope = 0.0;
+                    int bestTarget = 0;
+                    for (int target = 0; target < TARGET_COUNT; ++target) {
+                        double sum = 0.0, sumSlope = 0.0;
+                        for (const Outcome& outcome : outcomes[target]) {
+                            int left;
+                            X01Rules::Result result = rules.apply(remaining, outcome.segment, left);
+                            if (result == X01Rules::FINISHED) continue;
+                            if (result == X01Rules::BUST || (dartsLeft == 1 && left == turnStart)) {
+                                sum += outcome.probability * x;
+                                sumSlope += outcome.probability;
+                            }
+                            else if (dartsLeft == 1) {
+                                sum += outcome.probability * solved[left];
+                            }
+                            else {
+                                int next = turnOffset(dartsLeft - 1, turnStart - left);
+                                sum += outcome.probability * value[next];
+                                sumSlope += outcome.probability * slope[next];
+                            }
+                        }
+                        if (sum < best) {
+                            best = sum;
+                            bestSlope = sumSlope;
+                            bestTarget = target + 1;
+                        }
+                    }
+                    value[offset] = 1.0 + best;
+                    slope[offset] = bestSlope;
+                    targets[offset] = (unsigned char)bestTarget;
+                }
+            }
+
+            double error = value[0] - x;
+            if (std::fabs(error) < 1e-9 || slope[0] >= 1.0) break;
+            x += error / (1.0 - slope[0]);
+        }
+        solved[turnStart] = value[0];
+    }
+
+    file.close();
+    header = makeHeader(rules, sigma);
+    builtEntries.assign(ENTRY_COUNT, Entry());
+    for (int index = 0; index < ENTRY_COUNT; ++index) {
+        builtEntries[index].target = bestTargets[index];
+        builtEntries[index].expectedDarts = (std::uint16_t)std::min(65535.0, std::floor(expected[index] * 100.0 + 0.5));
+    }
+    entries = builtEntries.data();
+}
+
+bool CheckoutTable::save(const char* path) const {
+    if (!entries) return false;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not write checkout table: " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(entries), sizeof(Entry) * ENTRY_COUNT);
+    return out.good();
+}
+
+bool CheckoutTable::load(const char* path) {
+    if (!file.open(path)) return false;
+
+    Header loaded;
+    if (file.size() != sizeof(Header) + sizeof(Entry) * ENTRY_COUNT) {
+        std::cerr << "Error: Checkout table has the wrong size: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    std::memcpy(&loaded, file.data(), sizeof(Header));
+    if (std::memcmp(loaded.magic, MAGIC, sizeof(MAGIC)) != 0 || loaded.version != VERSION || loaded.entryCount != ENTRY_COUNT) {
+        std::cerr << "Error: Not a checkout table (or an old version): " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    header = loaded;
+    builtEntries.clear();
+    entries = reinterpret_cast<const Entry*>(file.data() + sizeof(Header));
+    return true;
+}
+
+bool CheckoutTable::isReady() const {
+    return entries != nullptr;
+}
+
+bool CheckoutTable::matches(const X01Rules& rules, float sigma) const {
+    Header wanted = makeHeader(rules, sigma);
+    return isReady() && header.flags == wanted.flags && header.startScore == wanted.startScore && header.sigma == wanted.sigma;
+}
+
+int CheckoutTable::turnOffset(int dartsLeft, int scored) {
+    if (dartsLeft < 1 || dartsLeft > 3 || scored < 0 || scored > 60 * (3 - dartsLeft)) return -1;
+    if (dartsLeft == 3) return 0;
+    if (dartsLeft == 2) return 1 + scored;
+    return 62 + scored;
+}
+
+CheckoutHint CheckoutTable::lookup(int remaining, int dartsLeft, int turnStart) const {
+    int offset = turnOffset(dartsLeft, turnStart - remaining);
+    if (!entries || turnStart < 0 || turnStart > MAX_SCORE || offset < 0) {
+        return { { 0, 0 }, 0.0f };
+    }
+    const Entry& entry = entries[(std::size_t)turnStart * ENTRIES_PER_TURN + offset];
+    if (entry.target == 0) return { { 0, 0 }, 0.0f };
+    return { ScoreGrid::decode(entry.target), entry.expectedDarts / 100.0f };
+}
+
+std::string CheckoutTable::targetName(const BoardSegment& target) {
+    if (target.number == 25) return target.multiplier == 2 ? "Bull" : "25";
+    if (target.number == 0) return "-";
+    const char* prefix = target.multiplier == 3 ? "T" : (target.multiplier == 2 ? "D" : "S");
+    return prefix + std::to_string(target.number);
+}
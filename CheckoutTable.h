@@ -0,0 +1,79 @@
+#ifndef CHECKOUTTABLE_H
+#define CHECKOUTTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BoardScorer.h"
+#include "MappedFile.h"
+#include "X01Rules.h"
+
+// Best segment to aim for with a given score left and darts left in the turn
+struct CheckoutHint {
+    BoardSegment target;    // { 0, 0 } when the table has no entry
+    float expectedDarts;    // Average darts to finish the leg, this one included
+
+    bool isValid() const { return target.number != 0; }
+};
+
+// Aim targets for every remaining score (up to 501) and darts-left count
+// (1-3, as in Player::getDartsLeft), solved offline to minimize the expected
+// number of darts to finish. A bust sends the score back to where the turn
+// started, so entries are also keyed by the score at the start of the turn.
+// The table is a flat array of 4-byte entries behind a small header, so a
+// saved table is memory-mapped and used in place.
+class CheckoutTable {
+public:
+    static const int MAX_SCORE = 501;
+
+    CheckoutTable();
+
+    // Solve for a thrower whose darts land with a circular Gaussian error of
+    // standard deviation sigma (board units) around the aim point
+    void build(const X01Rules& rules, float sigma, int samplesPerTarget = 20000, std::uint64_t seed = 1);
+    bool save(const char* path) const;
+    bool load(const char* path);
+
+    bool isReady() const;
+    bool matches(const X01Rules& rules, float sigma) const;  // Built for these settings?
+
+    // O(1); turnStart is the remaining score before the first dart of this turn
+    CheckoutHint lookup(int remaining, int dartsLeft, int turnStart) const;
+
+    static std::string targetName(const BoardSegment& target);  // "T20", "D16", "25", "Bull"
+
+private:
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t flags;        // Bit 0: double out
+        std::uint32_t startScore;
+        float sigma;
+        std::uint32_t entryCount;
+    };
+
+    struct Entry {
+        std::uint8_t target;        // ScoreGrid segment code, 0 if no entry
+        std::uint8_t reserved;
+        std::uint16_t expectedDarts; // Hundredths of a dart
+    };
+
+    static_assert(sizeof(Header) == 24, "table header must stay 24 bytes");
+    static_assert(sizeof(Entry) == 4, "table entries must stay 4 bytes");
+
+    static const std::uint32_t VERSION = 1;
+    // Per turn-start score: 1 entry with 3 darts left, 61 with 2 (0-60
+    // scored so far), 121 with 1 (0-120 scored so far)
+    static const int ENTRIES_PER_TURN = 1 + 61 + 121;
+    static const int ENTRY_COUNT = (MAX_SCORE + 1) * ENTRIES_PER_TURN;
+
+    Header header;
+    const Entry* entries;           // Points into builtEntries or the mapped file
+    std::vector<Entry> builtEntries;
+    MappedFile file;
+
+    static Header makeHeader(const X01Rules& rules, float sigma);
+    static int turnOffset(int dartsLeft, int scored);   // -1 if unreachable
+};
+
+#endif // CHECKOUTTABLE_H
@@ -11,30 +11,13 @@ T clamp(T value, T min, T max) {
     return value;
 }
 
-Crosshair::Crosshair() : x(0.0f), y(0.0f), shakeAmount(0.5f), shaderProgram(0) {}
+Crosshair::Crosshair() : x(0.0f), y(0.0f), shakeAmount(0.5f) {}
 
 
 Crosshair::~Crosshair() {
     // Cleanup OpenGL resources (e.g., deleting buffers)
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
-    glDeleteProgram(shaderProgram);
-}
-
-// Compile a shader from source
-unsigned int Crosshair::compileShader(GLenum type, const char* source) {
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Error compiling shader: " << infoLog << std::endl;
-    }
-    return shader;
 }
 
 void Crosshair::initialize() {
@@ -59,26 +42,13 @@ void Crosshair::initialize() {
     )";
 
 
-    // Compile shaders
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-
-    // Create shader program
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    int success;
-    char infoLog[512];
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cerr << "Error linking shader program for crosshair: " << infoLog << std::endl;
+    if (!shader.loadSource(vertexShaderSource, fragmentShaderSource)) {
+        std::cerr << "Error linking shader program for crosshair" << std::endl;
     }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    modelLoc = shader.getUniformLocation("model");
+    colorLoc = shader.getUniformLocation("crosshairColor");
+    if (modelLoc == -1) std::cerr << "Failed to find uniform 'model' in shader!" << std::endl;
+    if (colorLoc == -1) std::cerr << "Failed to find uniform 'crosshairColor' in shader!" << std::endl;
 
     // Crosshair geometry
     GLfloat vertices[] = {
@@ -134,14 +104,10 @@ void Crosshair::update(float dt) {
 
 void Crosshair::render() {
     // Use the shader program
-    glUseProgram(shaderProgram);
+    if (modelLoc == -1) return;
+    shader.use();
 
     // Set the crosshair position using a model matrix
-    GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-    if (modelLoc == -1) {
-        std::cerr << "Failed to find uniform 'model' in shader!" << std::endl;
-        return;
-    }
 
     // Create translation matrix to move crosshair to (x, y)
     float model[16] = {
@@ -167,16 +133,8 @@ void Crosshair::render() {
 
 void Crosshair::setColor(float r, float g, float b) {
     // Use the shader program
-    glUseProgram(shaderProgram);
-
-    // Find and set the crosshairColor uniform
-    GLint colorLoc = glGetUniformLocation(shaderProgram, "crosshairColor");
-    if (colorLoc != -1) {
-        glUniform3f(colorLoc, r, g, b);
-    }
-    else {
-        std::cerr << "Failed to find uniform 'crosshairColor' in shader!" << std::endl;
-    }
+    shader.use();
+    glUniform3f(colorLoc, r, g, b);
 
     // Unbind the shader program
     glUseProgram(0);
@@ -2,6 +2,7 @@
 #define CROSSHAIR_H
 
 #include <GL/glew.h>
+#include "ShaderProgram.h"
 
 class Crosshair {
 public:
@@ -16,10 +17,10 @@ public:
     float getY() const;
 
 private:
-    GLuint VAO, VBO, shaderProgram;
+    GLuint VAO, VBO;
+    ShaderProgram shader;
+    GLint modelLoc = -1, colorLoc = -1;
     float x, y, shakeAmount;
-
-    unsigned int compileShader(GLenum type, const char* source);
 };
 
 #endif
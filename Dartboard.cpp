@@ -1,23 +1,23 @@
 #include "Dartboard.h"
+#include "BoardScorer.h"
 #include <iostream>
 #include <cmath> // For sin, cos
-#include <fstream>
-#include <sstream>
-#include "stb_image.h"
+#include "TextureLoader.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 
 
 // Constants
-const float Dartboard::RADIUS = 0.4f;
+const float Dartboard::RADIUS = BoardSpec::RADIUS;
+const float Dartboard::DENSITY_SPLAT_SIGMA = 0.006f;   // About 3.5 mm
 #define M_PI 3.14159265358979323846
 
 Dartboard::Dartboard(const char* texturePath, const char* vertexShaderPath, const char* fragmentShaderPath) {
     generateCircleVertices(); // Generate circle vertices
 
     // Load the dartboard texture
-    textureID = loadImageToTexture(texturePath);
+    textureID = loadTexture(texturePath);
 
     // Set up OpenGL buffers for rendering the dartboard
     glGenVertexArrays(1, &VAO);
@@ -42,10 +42,9 @@ Dartboard::Dartboard(const char* texturePath, const char* vertexShaderPath, cons
     glBindVertexArray(0);
 
     // Load and compile shaders
-    shaderProgram = createShader(vertexShaderPath, fragmentShaderPath);
+    boardShader.loadFiles(vertexShaderPath, fragmentShaderPath);
+    setupBoardShader(boardShader, "dartboardTexture");
 
-    // Initialize marker resources
-    setupMarker();
     setupDart();
     setupDartMesh();
 }
@@ -62,13 +61,17 @@ Dartboard::~Dartboard() {
     glDeleteTextures(1, &textureID);
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
-    glDeleteProgram(shaderProgram);
-    glDeleteBuffers(1, &markerVBO);
-    glDeleteVertexArrays(1, &markerVAO);
-    glDeleteProgram(markerShaderProgram);
+    glDeleteFramebuffers(1, &densityFBO);
+    glDeleteTextures(1, &densityTexture);
+    glDeleteVertexArrays(1, &densitySplatVAO);
+    glDeleteBuffers(1, &densitySplatVBO);
     glDeleteVertexArrays(1, &dartVAO);
     glDeleteBuffers(1, &dartVBO);
-    glDeleteProgram(dartShaderProgram);
+    glDeleteVertexArrays(1, &dartMeshVAO);
+    glDeleteBuffers(1, &dartMeshVBO);
+    glDeleteBuffers(1, &dartMeshEBO);
+    glDeleteBuffers(1, &dartInstanceVBO);
+    glDeleteTextures(1, &heatmapTexture);
 
 }
 
@@ -115,34 +118,18 @@ void Dartboard::generateCircleVertices() {
 
 
 
-void Dartboard::render(const glm::mat4& projection, const glm::mat4& view) {
-    glUseProgram(shaderProgram);
-    glBindVertexArray(VAO);
-
-    // Set the projection, view, and model matrices
-    unsigned int projectionLoc = glGetUniformLocation(shaderProgram, "projection");
-    unsigned int viewLoc = glGetUniformLocation(shaderProgram, "view");
-    unsigned int modelLoc = glGetUniformLocation(shaderProgram, "model");
-
-    glm::mat4 model = glm::mat4(1.0f); // Identity matrix for model
-
-    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-    // Set Phong lighting uniforms for the dartboard
-    glm::vec3 lightPos(0.0f, 0.0f, 2.0f); // Light above the board
-    glm::vec3 viewPos(0.0f, 0.0f, 2.0f);  // Camera position (adjust as needed)
-    glm::vec3 lightColor(1.0f, 1.0f, 1.0f); // White light
+void Dartboard::render() {
+    renderBoard();
+    renderDarts();
+}
 
-    glUniform3fv(glGetUniformLocation(shaderProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-    glUniform3fv(glGetUniformLocation(shaderProgram, "viewPos"), 1, glm::value_ptr(viewPos));
-    glUniform3fv(glGetUniformLocation(shaderProgram, "lightColor"), 1, glm::value_ptr(lightColor));
+void Dartboard::renderBoard() {
+    boardShader.use();
+    glBindVertexArray(VAO);
 
     // Bind the texture
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textureID);
-    glUniform1i(glGetUniformLocation(shaderProgram, "dartboardTexture"), 0);
 
     // Render the front face
     glDrawArrays(GL_TRIANGLE_FAN, 0, NUM_SEGMENTS + 2);
@@ -151,126 +138,27 @@ void Dartboard::render(const glm::mat4& projection, const glm::mat4& view) {
     glBindVertexArray(0);
     glUseProgram(0);
 
-    // Render the hit markers after rendering the dartboard
-    renderDarts(projection, view);
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-void Dartboard::setupMarker() {
-    // Simple shader for hit markers
-    const char* markerVertexShader = R"(
-        #version 330 core
-        layout(location = 0) in vec2 position;
-        uniform vec2 offset;
-        void main() {
-            gl_Position = vec4(position + offset, 0.0, 1.0);
-        }
-    )";
-
-    const char* markerFragmentShader = R"(
-        #version 330 core
-        out vec4 fragColor;
-        void main() {
-            fragColor = vec4(1.0, 1.0, 0.0, 1.0); // Yellow color for markers
-        }
-    )";
-
-    // Compile and link marker shaders
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &markerVertexShader, nullptr);
-    glCompileShader(vertexShader);
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &markerFragmentShader, nullptr);
-    glCompileShader(fragmentShader);
-
-    markerShaderProgram = glCreateProgram();
-    glAttachShader(markerShaderProgram, vertexShader);
-    glAttachShader(markerShaderProgram, fragmentShader);
-    glLinkProgram(markerShaderProgram);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    // Set up the VAO/VBO for the markers (X shape)
-    float markerVertices[] = {
-        -0.03f, -0.03f, // Bottom-left to Top-right
-         0.03f,  0.03f,
-
-        -0.03f,  0.03f, // Top-left to Bottom-right
-         0.03f, -0.03f
-    };
-
-    glGenVertexArrays(1, &markerVAO);
-    glGenBuffers(1, &markerVBO);
-
-    glBindVertexArray(markerVAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, markerVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(markerVertices), markerVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    if (heatmapTexture != 0) {
+        renderExpectedScoreOverlay();
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    if (showHitDensity) {
+        splatDensityHits();
+        renderHitDensity();
+    }
 }
 
+unsigned long long Dartboard::getBoardVersion() const {
+    return boardVersion;
+}
 
-void Dartboard::renderHitMarkers() {
-    glUseProgram(markerShaderProgram);
-
-    // Check if the shader program is valid
-    if (markerShaderProgram == 0) {
-        std::cerr << "Error: Marker shader program is not valid!" << std::endl;
-        return;
-    }
-
-    glBindVertexArray(markerVAO);
 
-    // Set the line width (adjust thickness as needed)
-    glLineWidth(4.0f); // Thicker lines for the X marker
 
-    // Render each marker
-    for (const auto& hit : hitPositions) {
-        // Check if the uniform location is valid
-        GLint offsetLocation = glGetUniformLocation(markerShaderProgram, "offset");
-        if (offsetLocation == -1) {
-            std::cerr << "Error: Uniform 'offset' not found!" << std::endl;
-            continue;
-        }
 
-        // Debugging output for verification
-        std::cout << "Rendering hit marker at: (" << hit.first << ", " << hit.second << ")" << std::endl;
 
-        // Set the uniform for the marker position
-        glUniform2f(offsetLocation, hit.first, hit.second);
 
-        // Draw the X marker using GL_LINES
-        glDrawArrays(GL_LINES, 0, 4);
 
-        // Check for OpenGL errors
-        GLenum err;
-        while ((err = glGetError()) != GL_NO_ERROR) {
-            std::cerr << "OpenGL Error: " << err << std::endl;
-        }
-    }
 
-    glBindVertexArray(0);
-    glUseProgram(0);
-}
 
 
 
@@ -280,7 +168,7 @@ void Dartboard::renderHitMarkers() {
 void Dartboard::recordHit(float x, float y) {
     glm::vec3 pos(x, y, 0.1f); // Board is at z=0.1f
     glm::vec3 dir(0.0f, 0.0f, -1.0f); // Dart points into the board
-    dartHits.push_back({ pos, dir });
+    dartModels.push_back(dartModel(pos, dir));
     std::cout << "Recorded dart at: (" << x << ", " << y << ", 0.1)" << std::endl;
 
 }
@@ -290,134 +178,87 @@ void Dartboard::recordHit(float x, float y) {
 
 
 
-unsigned int Dartboard::loadImageToTexture(const char* filePath) {
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath, &width, &height, &channels, 0);
+// Programs drawn over the board disc with basic.vert: the board never moves,
+// and its texture is always on unit 0
+void Dartboard::setupBoardShader(ShaderProgram& shader, const char* samplerName) {
+    glm::mat4 model = glm::mat4(1.0f);
+    shader.use();
+    glUniformMatrix4fv(shader.getUniformLocation("model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniform1i(shader.getUniformLocation(samplerName), 0);
+    glUseProgram(0);
+}
 
-    if (!data) {
-        std::cout << "Failed to load texture!" << std::endl;
-        return 0;
-    }
+int Dartboard::calculateScore(float x, float y) {
+    return BoardScorer().score(x, y);
+}
 
-    GLint internalFormat = (channels == 4) ? GL_RGBA : GL_RGB;
-    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
 
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    stbi_image_free(data);
-    return textureID;
+void Dartboard::clearHits() {
+    dartModels.clear();
+    dartInstancesUploaded = 0;
 }
 
-unsigned int Dartboard::compileShader(GLenum type, const char* sourcePath) {
-    std::ifstream file(sourcePath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open shader file: " << sourcePath << std::endl;
-        return 0;
+void Dartboard::setExpectedScoreOverlay(const std::vector<float>& values, int resolution) {
+    if (values.size() != (size_t)resolution * resolution) {
+        std::cerr << "Error: Expected score overlay has the wrong size!" << std::endl;
+        return;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string sourceCode = buffer.str();
-    const char* source = sourceCode.c_str();
-
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Error compiling shader: " << infoLog << std::endl;
+    if (!heatmapShader.isValid()) {
+        heatmapShader.loadFiles("basic.vert", "heatmap.frag");
+        setupBoardShader(heatmapShader, "heatmapTexture");
+        heatmapMaxLoc = heatmapShader.getUniformLocation("maxValue");
     }
-    return shader;
-}
 
-unsigned int Dartboard::createShader(const char* vertexShaderPath, const char* fragmentShaderPath) {
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderPath);
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderPath);
-
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    int success;
-    char infoLog[512];
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cerr << "Error linking shader program: " << infoLog << std::endl;
+    if (heatmapTexture == 0) {
+        glGenTextures(1, &heatmapTexture);
     }
+    glBindTexture(GL_TEXTURE_2D, heatmapTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
-}
-
-int Dartboard::calculateScore(float x, float y, float zoomLevel) {
-    // Convert Cartesian coordinates to polar coordinates
-    float radius = sqrt(x * x + y * y);
-    float angle = atan2(y, x);  // Angle in radians
-
-    // Normalize angle to [0, 2?)
-    if (angle < 0) {
-        angle += 2 * M_PI;  // Normalize negative angles
+    // Same size as last time: update in place instead of reallocating
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (resolution == heatmapResolution) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, resolution, resolution, GL_RED, GL_FLOAT, values.data());
     }
+    else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, resolution, resolution, 0, GL_RED, GL_FLOAT, values.data());
+        heatmapResolution = resolution;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    float rotationOffset = 80 * (M_PI / 180.0f);  // 5 degrees converted to radians
-    angle -= rotationOffset;  // Apply the small rotation to the angle
-    if (angle < 0) {
-        angle += 2 * M_PI;
+    heatmapMax = 0.0f;
+    for (float value : values) {
+        if (value > heatmapMax) heatmapMax = value;
     }
+    ++boardVersion;
+}
 
-    // Convert angle to sector (assuming 20 equally spaced sectors)
-    int sector = (int)(angle / (2 * M_PI) * 20) % 20;
-
-    // Adjust radius thresholds based on zoom level
-    float bullseyeInnerRadius = 0.01f * (zoomLevel + 0.10);
-    float bullseyeOuterRadius = 0.02f * (zoomLevel + 0.5);
-    float outerRadius = 0.26f * (zoomLevel + 0.15);
-    float doubleRingInnerRadius = 0.185f * (zoomLevel + 0.5);
-    float doubleRingOuterRadius = 0.27f * (zoomLevel + 0.1);
-    float tripleRingInnerRadius = 0.15f * (zoomLevel + 0.15);
-    float tripleRingOuterRadius = 0.169f * (zoomLevel + 0.15);
-
-    // Debugging output for verification
-    std::cout << "Hit Position: (" << x << ", " << y << "), "
-        << "Radius: " << radius << ", "
-        << "Angle (rad): " << angle << ", "
-        << "Sector: " << sector << std::endl;
-
-    // Score zones (adjust thresholds based on dartboard layout)
-    if (radius <= bullseyeInnerRadius) return 50;  // Bullseye (inner red circle)
-    if (radius <= bullseyeOuterRadius) return 25;  // Outer bullseye (green circle)
-    if (radius > outerRadius) return 0;    // Outside the dartboard
-
-    // Check double and triple rings
-    if (radius > doubleRingInnerRadius && radius <= doubleRingOuterRadius) return sectors[sector] * 2;  // Double ring
-    if (radius > tripleRingInnerRadius && radius <= tripleRingOuterRadius) return sectors[sector] * 3;  // Triple ring
-
-    // Regular scoring
-    return sectors[sector];
+void Dartboard::clearExpectedScoreOverlay() {
+    glDeleteTextures(1, &heatmapTexture);
+    heatmapTexture = 0;
+    heatmapResolution = 0;
+    ++boardVersion;
 }
 
+void Dartboard::renderExpectedScoreOverlay() {
+    heatmapShader.use();
+    glBindVertexArray(VAO);
 
+    glUniform1f(heatmapMaxLoc, heatmapMax > 0.0f ? heatmapMax : 1.0f);
 
-void Dartboard::clearHits() {
-    dartHits.clear();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, heatmapTexture);
+
+    glDrawArrays(GL_TRIANGLE_FAN, 0, NUM_SEGMENTS + 2);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
 }
 
 void Dartboard::setupDart() {
@@ -436,17 +277,49 @@ void Dartboard::setupDart() {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
-    dartShaderProgram = createShader("dart.vert", "dart.frag");
-    std::cout << "dartShaderProgram: " << dartShaderProgram << std::endl;
+    dartShader.loadFiles("dart.vert", "dart.frag");
+    std::cout << "dartShaderProgram: " << dartShader.getId() << std::endl;
+
+    // The dart colour never changes; camera and lighting are shared blocks
+    glm::vec3 objectColor(0.8f, 0.2f, 0.2f); // Dart color (reddish)
+    dartShader.use();
+    glUniform3fv(dartShader.getUniformLocation("objectColor"), 1, glm::value_ptr(objectColor));
+    glUseProgram(0);
 }
 
-void Dartboard::renderDarts(const glm::mat4& projection, const glm::mat4& view) {
-    for (const auto& dart : dartHits) {
-        renderSingleDart(dart.position, dart.direction, projection, view);
+// All darts in one instanced draw
+void Dartboard::renderDarts() {
+    if (dartModels.empty()) return;
+    uploadDartInstances();
+
+    dartShader.use();
+
+    glBindVertexArray(dartMeshVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(dartMeshIndices.size()), GL_UNSIGNED_INT, 0,
+        static_cast<GLsizei>(dartModels.size()));
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+// Send darts added since the last frame; reallocate (doubling) only when
+// the buffer is full
+void Dartboard::uploadDartInstances() {
+    if (dartInstancesUploaded == dartModels.size()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, dartInstanceVBO);
+    if (dartModels.size() > dartInstanceCapacity) {
+        while (dartInstanceCapacity < dartModels.size()) dartInstanceCapacity *= 2;
+        glBufferData(GL_ARRAY_BUFFER, dartInstanceCapacity * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+        dartInstancesUploaded = 0;
     }
+    glBufferSubData(GL_ARRAY_BUFFER, dartInstancesUploaded * sizeof(glm::mat4),
+        (dartModels.size() - dartInstancesUploaded) * sizeof(glm::mat4), &dartModels[dartInstancesUploaded]);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    dartInstancesUploaded = dartModels.size();
 }
 
-void Dartboard::renderSingleDart(const glm::vec3& pos, const glm::vec3& dir, const glm::mat4& projection, const glm::mat4& view) {
+glm::mat4 Dartboard::dartModel(const glm::vec3& pos, const glm::vec3& dir) {
     // Build the model matrix: translate to dart position, then orient along dir
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, pos);
@@ -461,9 +334,7 @@ void Dartboard::renderSingleDart(const glm::vec3& pos, const glm::vec3& dir, con
             model = glm::rotate(model, angle, glm::normalize(axis));
         }
     }
-
-    // Render the dart mesh
-    renderDartMesh(model, view, projection);
+    return model;
 }
 
 
@@ -624,34 +495,179 @@ void Dartboard::setupDartMesh() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
+    // Per-dart model matrix: four vec4 columns at locations 2-5, one per instance
+    const size_t INITIAL_DART_CAPACITY = 64;
+    glGenBuffers(1, &dartInstanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, dartInstanceVBO);
+    dartInstanceCapacity = INITIAL_DART_CAPACITY;
+    glBufferData(GL_ARRAY_BUFFER, dartInstanceCapacity * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    for (int column = 0; column < 4; ++column) {
+        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(2 + column);
+        glVertexAttribDivisor(2 + column, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
     glBindVertexArray(0);
 }
 
+void Dartboard::addDensityHit(float x, float y) {
+    if (std::fabs(x) >= RADIUS || std::fabs(y) >= RADIUS) return;  // Off the board
+    pendingDensityHits.push_back(x);
+    pendingDensityHits.push_back(y);
+
+    // Coarse counts on the CPU give the colour scale without reading back the texture
+    if (densityBins.empty()) densityBins.assign(DENSITY_BINS * DENSITY_BINS, 0);
+    int column = (int)((x / RADIUS * 0.5f + 0.5f) * DENSITY_BINS);
+    int row = (int)((y / RADIUS * 0.5f + 0.5f) * DENSITY_BINS);
+    // Just inside the edge, x / RADIUS * 0.5f + 0.5f can round up to 1.0f
+    if (column > DENSITY_BINS - 1) column = DENSITY_BINS - 1;
+    if (row > DENSITY_BINS - 1) row = DENSITY_BINS - 1;
+    if (column < 0) column = 0;
+    if (row < 0) row = 0;
+    unsigned int count = ++densityBins[row * DENSITY_BINS + column];
+    if (count > densityMaxBin) densityMaxBin = count;
+    if (showHitDensity) ++boardVersion;
+}
 
+void Dartboard::clearHitDensity() {
+    pendingDensityHits.clear();
+    densityBins.clear();
+    densityMaxBin = 0;
+    if (showHitDensity) ++boardVersion;
+    if (densityFBO == 0) return;
 
-void Dartboard::renderDartMesh(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection) {
-    glUseProgram(dartShaderProgram);
-    glBindVertexArray(dartMeshVAO);
+    GLint previousFramebuffer;
+    GLfloat previousClearColor[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
 
-    // Set transformation matrices
-    glUniformMatrix4fv(glGetUniformLocation(dartShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniformMatrix4fv(glGetUniformLocation(dartShaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(dartShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glBindFramebuffer(GL_FRAMEBUFFER, densityFBO);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
 
-    // Set Phong lighting uniforms
-    glm::vec3 lightPos(0.0f, 0.0f, 2.0f); // Light above the board
-    glm::vec3 viewPos(0.0f, 0.0f, 2.0f);  // Camera position (match your camera)
-    glm::vec3 objectColor(0.8f, 0.2f, 0.2f); // Dart color (reddish)
-    glm::vec3 lightColor(1.0f, 1.0f, 1.0f);  // White light
+    glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+}
+
+void Dartboard::setHitDensityVisible(bool visible) {
+    if (visible != showHitDensity) ++boardVersion;
+    showHitDensity = visible;
+}
+
+bool Dartboard::isHitDensityVisible() const {
+    return showHitDensity;
+}
+
+void Dartboard::setupHitDensity() {
+    // R32F accumulation target covering [-RADIUS, RADIUS] in x and y
+    glGenTextures(1, &densityTexture);
+    glBindTexture(GL_TEXTURE_2D, densityTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, DENSITY_RESOLUTION, DENSITY_RESOLUTION, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGenFramebuffers(1, &densityFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, densityFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, densityTexture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Error: Hit density framebuffer is incomplete!" << std::endl;
+    }
+    GLfloat previousClearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+    glGenVertexArrays(1, &densitySplatVAO);
+    glGenBuffers(1, &densitySplatVBO);
+    glBindVertexArray(densitySplatVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, densitySplatVBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    float texelsPerUnit = DENSITY_RESOLUTION / (2.0f * RADIUS);
+    densitySplatShader.loadFiles("density_splat.vert", "density_splat.frag");
+    densitySplatShader.use();
+    glUniform1f(densitySplatShader.getUniformLocation("boardRadius"), RADIUS);
+    glUniform1f(densitySplatShader.getUniformLocation("pointSize"), 6.0f * DENSITY_SPLAT_SIGMA * texelsPerUnit);
+    glUseProgram(0);
 
-    glUniform3fv(glGetUniformLocation(dartShaderProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-    glUniform3fv(glGetUniformLocation(dartShaderProgram, "viewPos"), 1, glm::value_ptr(viewPos));
-    glUniform3fv(glGetUniformLocation(dartShaderProgram, "objectColor"), 1, glm::value_ptr(objectColor));
-    glUniform3fv(glGetUniformLocation(dartShaderProgram, "lightColor"), 1, glm::value_ptr(lightColor));
+    densityShader.loadFiles("basic.vert", "density.frag");
+    setupBoardShader(densityShader, "densityTexture");
+    densityMaxLoc = densityShader.getUniformLocation("maxValue");
+}
+
+// Adds every hit queued since the last frame to the texture in one draw:
+// a Gaussian point sprite per hit, summed with additive blending
+void Dartboard::splatDensityHits() {
+    if (pendingDensityHits.empty()) return;
+    if (densityFBO == 0) setupHitDensity();
+
+    GLint previousFramebuffer, previousViewport[4];
+    GLint blendSrcRgb, blendDstRgb, blendSrcAlpha, blendDstAlpha;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRgb);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRgb);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+    GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, densityFBO);
+    glViewport(0, 0, DENSITY_RESOLUTION, DENSITY_RESOLUTION);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+
+    glBindBuffer(GL_ARRAY_BUFFER, densitySplatVBO);
+    glBufferData(GL_ARRAY_BUFFER, pendingDensityHits.size() * sizeof(float), pendingDensityHits.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    densitySplatShader.use();
+    glBindVertexArray(densitySplatVAO);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(pendingDensityHits.size() / 2));
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glBlendFuncSeparate(blendSrcRgb, blendDstRgb, blendSrcAlpha, blendDstAlpha);
+    if (!blendEnabled) glDisable(GL_BLEND);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+    pendingDensityHits.clear();
+}
 
-    // Draw the dart mesh
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(dartMeshIndices.size()), GL_UNSIGNED_INT, 0);
+void Dartboard::renderHitDensity() {
+    if (densityTexture == 0 || densityMaxBin == 0) return;
 
+    densityShader.use();
+    glBindVertexArray(VAO);
+
+    // The texture holds summed Gaussians of peak 1, each adding 2 pi sigma^2
+    // over the board, so n hits spread over one bin read as n times that over
+    // the bin's area. Hits stacked tighter than a bin read higher and saturate,
+    // and a lone hit is never scaled below its own peak.
+    float binWidth = 2.0f * RADIUS / DENSITY_BINS;
+    float splatArea = 2.0f * (float)M_PI * DENSITY_SPLAT_SIGMA * DENSITY_SPLAT_SIGMA;
+    float maxValue = densityMaxBin * splatArea / (binWidth * binWidth);
+    glUniform1f(densityMaxLoc, maxValue > 1.0f ? maxValue : 1.0f);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, densityTexture);
+
+    glDrawArrays(GL_TRIANGLE_FAN, 0, NUM_SEGMENTS + 2);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
     glBindVertexArray(0);
     glUseProgram(0);
 }
@@ -6,20 +6,32 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/glm.hpp>
-struct DartHit {
-    glm::vec3 position;
-    glm::vec3 direction;
-};
+#include "ShaderProgram.h"
 
 class Dartboard {
 public:
     Dartboard(const char* texturePath, const char* vertexShaderPath, const char* fragmentShaderPath);
     ~Dartboard();
-    void render(const glm::mat4& projection, const glm::mat4& view);
-    int calculateScore(float x, float y, float zoomLevel);
+    void render();  // Camera and lighting come from SceneUniforms
+    // render() in two parts: the board with its overlays, which only change
+    // when getBoardVersion does (so SceneCache can keep them), and the darts
+    void renderBoard();
+    void renderDarts();
+    unsigned long long getBoardVersion() const;
+    int calculateScore(float x, float y);  // x, y in board space
     void recordHit(float x, float y);
-    void renderHitMarkers();
     void clearHits();
+    // Long-term hit density (a whole season), drawn as a colour map over the
+    // board. Each hit is splatted once into a float texture on the GPU, so
+    // drawing the layer costs the same for ten hits or a million.
+    void addDensityHit(float x, float y);
+    void clearHitDensity();
+    void setHitDensityVisible(bool visible);
+    bool isHitDensityVisible() const;
+    // Tints the board by expected score; values is resolution x resolution,
+    // row 0 at the bottom edge of the board (y = -RADIUS)
+    void setExpectedScoreOverlay(const std::vector<float>& values, int resolution);
+    void clearExpectedScoreOverlay();
     static const float RADIUS;
 
 
@@ -28,28 +40,46 @@ private:
     std::vector<unsigned int> dartMeshIndices;
     unsigned int dartMeshVAO = 0, dartMeshVBO = 0, dartMeshEBO = 0;
     unsigned int dartVAO = 0, dartVBO = 0;
-    unsigned int dartShaderProgram = 0;
-    std::vector<DartHit> dartHits;
+    ShaderProgram dartShader;
+    // One model matrix per dart, mirrored in dartInstanceVBO; the buffer only
+    // grows, so clearHits keeps its storage
+    std::vector<glm::mat4> dartModels;
+    unsigned int dartInstanceVBO = 0;
+    size_t dartInstanceCapacity = 0;
+    size_t dartInstancesUploaded = 0;
     unsigned int VAO, VBO;
-    unsigned int shaderProgram;
+    ShaderProgram boardShader;
     unsigned int textureID;
-    unsigned int markerVAO, markerVBO;
-    unsigned int markerShaderProgram;
+    unsigned int heatmapTexture = 0;
+    ShaderProgram heatmapShader;
+    GLint heatmapMaxLoc = -1;
+    int heatmapResolution = 0;
+    float heatmapMax = 0.0f;
+    static const int DENSITY_RESOLUTION = 512;  // Texels across the board
+    static const int DENSITY_BINS = 64;         // CPU bins for the colour scale
+    static const float DENSITY_SPLAT_SIGMA;     // Board units
+    unsigned int densityFBO = 0, densityTexture = 0;
+    ShaderProgram densitySplatShader, densityShader;
+    GLint densityMaxLoc = -1;
+    unsigned int densitySplatVAO = 0, densitySplatVBO = 0;
+    std::vector<float> pendingDensityHits;      // x, y pairs not splatted yet
+    std::vector<unsigned int> densityBins;
+    unsigned int densityMaxBin = 0;
+    bool showHitDensity = false;
+    unsigned long long boardVersion = 1;        // Bumped by every change to the overlays
     static const int NUM_SEGMENTS = 100;
     std::vector<float> vertices;
-    int sectors[20] = { 20, 5, 12, 9, 14, 11, 8, 16, 7, 19, 3, 17, 2, 15, 10, 6, 13, 4, 18, 1 };
-    std::vector<std::pair<float, float>> hitPositions;
 
     void generateCircleVertices();
-    unsigned int loadImageToTexture(const char* filePath);
-    unsigned int compileShader(GLenum type, const char* sourcePath);
-    unsigned int createShader(const char* vertexShaderPath, const char* fragmentShaderPath);
-    void setupMarker();
+    static void setupBoardShader(ShaderProgram& shader, const char* samplerName);
+    void setupHitDensity();
+    void splatDensityHits();
+    void renderHitDensity();
     void setupDart();
-    void renderDarts(const glm::mat4& projection, const glm::mat4& view);
-    void renderSingleDart(const glm::vec3& pos, const glm::vec3& dir, const glm::mat4& projection, const glm::mat4& view);
+    void renderExpectedScoreOverlay();
+    static glm::mat4 dartModel(const glm::vec3& pos, const glm::vec3& dir);
+    void uploadDartInstances();
     void setupDartMesh();
-    void renderDartMesh(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection);
 };
 
 #endif // DARTBOARD_H
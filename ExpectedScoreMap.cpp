@@ -0,0 +1,174 @@
+#include "ExpectedScoreMap.h"
+#include "BoardScorer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+static const double PI = 3.14159265358979323846;
+
+ExpectedScoreMap::ExpectedScoreMap(int resolution, unsigned threads)
+    : resolution(resolution), fftSize(resolution * 2), extent(BoardSpec::RADIUS) {
+    threadCount = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // exp(-2 pi i k / n) for the first half of the unit circle
+    twiddles.resize(fftSize / 2);
+    for (int k = 0; k < fftSize / 2; ++k) {
+        double angle = -2.0 * PI * k / fftSize;
+        twiddles[k] = std::complex<float>((float)std::cos(angle), (float)std::sin(angle));
+    }
+
+    scoreSpectrum.assign((std::size_t)fftSize * fftSize, std::complex<float>(0.0f, 0.0f));
+    rasterizeScores(scoreSpectrum);
+    fft2d(scoreSpectrum, false);
+}
+
+int ExpectedScoreMap::getResolution() const {
+    return resolution;
+}
+
+float ExpectedScoreMap::getExtent() const {
+    return extent;
+}
+
+void ExpectedScoreMap::clearCache() {
+    cache.clear();
+}
+
+// Average score of each cell (2x2 supersampled) in the top-left quarter of field
+void ExpectedScoreMap::rasterizeScores(std::vector<std::complex<float>>& field) const {
+    BoardScorer scorer;
+    float cellSize = 2.0f * extent / resolution;
+
+    std::vector<float> xs(resolution * 4), ys(resolution * 4);
+    std::vector<int> scores(resolution * 4);
+    for (int row = 0; row < resolution; ++row) {
+        for (int column = 0; column < resolution; ++column) {
+            for (int sample = 0; sample < 4; ++sample) {
+                xs[column * 4 + sample] = -extent + (column + 0.25f + 0.5f * (sample & 1)) * cellSize;
+                ys[column * 4 + sample] = -extent + (row + 0.25f + 0.5f * (sample >> 1)) * cellSize;
+            }
+        }
+        scorer.scoreBatch(xs.data(), ys.data(), scores.data(), scores.size());
+
+        for (int column = 0; column < resolution; ++column) {
+            const int* cell = &scores[column * 4];
+            float average = (cell[0] + cell[1] + cell[2] + cell[3]) * 0.25f;
+            field[(std::size_t)row * fftSize + column] = std::complex<float>(average, 0.0f);
+        }
+    }
+}
+
+// In-place iterative radix-2 FFT of fftSize points
+void ExpectedScoreMap::fft(std::complex<float>* data, bool inverse) const {
+    int n = fftSize;
+    for (int i = 1, j = 0; i < n; ++i) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+
+    for (int length = 2; length <= n; length <<= 1) {
+        int half = length / 2;
+        int stride = n / length;
+        for (int start = 0; start < n; start += length) {
+            for (int k = 0; k < half; ++k) {
+                std::complex<float> w = twiddles[k * stride];
+                float wr = w.real();
+                float wi = inverse ? -w.imag() : w.imag();
+                std::complex<float>& a = data[start + k];
+                std::complex<float>& b = data[start + k + half];
+                // Written out to skip the NaN/infinity handling of std::complex operator*
+                float tr = b.real() * wr - b.imag() * wi;
+                float ti = b.real() * wi + b.imag() * wr;
+                b = std::complex<float>(a.real() - tr, a.imag() - ti);
+                a = std::complex<float>(a.real() + tr, a.imag() + ti);
+            }
+        }
+    }
+}
+
+void ExpectedScoreMap::fft2d(std::vector<std::complex<float>>& data, bool inverse) const {
+    int n = fftSize;
+
+    parallelFor(n, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+            fft(&data[(std::size_t)row * n], inverse);
+        }
+    });
+
+    parallelFor(n, [&](int begin, int end) {
+        std::vector<std::complex<float>> column(n);
+        for (int c = begin; c < end; ++c) {
+            for (int row = 0; row < n; ++row) column[row] = data[(std::size_t)row * n + c];
+            fft(column.data(), inverse);
+            for (int row = 0; row < n; ++row) data[(std::size_t)row * n + c] = column[row];
+        }
+    });
+}
+
+void ExpectedScoreMap::parallelFor(int count, const std::function<void(int begin, int end)>& body) const {
+    unsigned workers = std::min<unsigned>(threadCount, (unsigned)count);
+    if (workers <= 1) {
+        body(0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    int chunk = (count + workers - 1) / workers;
+    for (unsigned i = 0; i < workers; ++i) {
+        int begin = i * chunk;
+        int end = std::min(count, begin + chunk);
+        if (begin < end) threads.emplace_back(body, begin, end);
+    }
+    for (std::thread& thread : threads) thread.join();
+}
+
+const std::vector<float>& ExpectedScoreMap::compute(float sigma) {
+    auto cached = cache.find(sigma);
+    if (cached != cache.end()) {
+        cached->second.lastUsed = ++useCount;
+        return cached->second.values;
+    }
+
+    int n = fftSize;
+    float cellSize = 2.0f * extent / resolution;
+
+    // The Fourier transform of a Gaussian is a Gaussian, and it separates by axis
+    std::vector<float> transfer(n);
+    for (int k = 0; k < n; ++k) {
+        double frequency = (k < n / 2 ? k : k - n) / (n * (double)cellSize);
+        transfer[k] = (float)std::exp(-2.0 * PI * PI * sigma * sigma * frequency * frequency);
+    }
+
+    std::vector<std::complex<float>> spectrum(scoreSpectrum.size());
+    parallelFor(n, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+            for (int column = 0; column < n; ++column) {
+                std::size_t index = (std::size_t)row * n + column;
+                spectrum[index] = scoreSpectrum[index] * (transfer[row] * transfer[column]);
+            }
+        }
+    });
+    fft2d(spectrum, true);
+
+    if (cache.size() >= MAX_CACHED) {
+        auto oldest = cache.begin();
+        for (auto candidate = cache.begin(); candidate != cache.end(); ++candidate) {
+            if (candidate->second.lastUsed < oldest->second.lastUsed) oldest = candidate;
+        }
+        cache.erase(oldest);
+    }
+    CachedMap& entry = cache[sigma];
+    entry.lastUsed = ++useCount;
+    std::vector<float>& expected = entry.values;
+    expected.resize((std::size_t)resolution * resolution);
+    float normalization = 1.0f / ((float)n * n);
+    for (int row = 0; row < resolution; ++row) {
+        for (int column = 0; column < resolution; ++column) {
+            float value = spectrum[(std::size_t)row * n + column].real() * normalization;
+            expected[(std::size_t)row * resolution + column] = std::max(0.0f, value);
+        }
+    }
+    return expected;
+}
@@ -0,0 +1,50 @@
+#ifndef EXPECTEDSCOREMAP_H
+#define EXPECTEDSCOREMAP_H
+
+#include <complex>
+#include <functional>
+#include <map>
+#include <vector>
+
+// Expected score for every aim point on the board when throws land with a
+// circular Gaussian error of standard deviation sigma (board units).
+// The score field is rasterized and transformed once; each sigma then costs
+// one spectrum multiply and one inverse FFT instead of a per-pixel sum.
+class ExpectedScoreMap {
+public:
+    // resolution must be a power of two; threads = 0 uses every core
+    ExpectedScoreMap(int resolution = 256, unsigned threads = 0);
+
+    // resolution x resolution grid, row 0 at y = -extent. Cached per sigma.
+    // Accurate for sigma up to roughly a quarter of the extent.
+    const std::vector<float>& compute(float sigma);
+
+    int getResolution() const;
+    float getExtent() const;           // The grid covers [-extent, extent] on both axes
+    void clearCache();
+
+private:
+    static const std::size_t MAX_CACHED = 32;
+
+    struct CachedMap {
+        std::vector<float> values;
+        unsigned long long lastUsed;    // useCount when last returned
+    };
+
+    int resolution;
+    int fftSize;                       // Zero-padded to twice the resolution so the
+                                       // convolution does not wrap around
+    float extent;
+    unsigned threadCount;
+    std::vector<std::complex<float>> twiddles;
+    std::vector<std::complex<float>> scoreSpectrum;
+    std::map<float, CachedMap> cache;  // Full: the least recently used map goes
+    unsigned long long useCount = 0;
+
+    void rasterizeScores(std::vector<std::complex<float>>& field) const;
+    void fft(std::complex<float>* data, bool inverse) const;
+    void fft2d(std::vector<std::complex<float>>& data, bool inverse) const;
+    void parallelFor(int count, const std::function<void(int begin, int end)>& body) const;
+};
+
+#endif // EXPECTEDSCOREMAP_H
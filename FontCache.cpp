@@ -0,0 +1,220 @@
+#include "FontCache.h"
+#include <algorithm>
+#include <iostream>
+
+Font::Font(FT_Face face, int pixelSize, Mode mode) : face(face), pixelSize(pixelSize), mode(mode) {
+    FT_Set_Pixel_Sizes(face, 0, pixelSize);
+
+    // Cells fit the largest glyph in the font, its distance field margin and
+    // a pixel of padding each side
+    int glyphWidth = (int)(FT_MulFix(face->bbox.xMax - face->bbox.xMin, face->size->metrics.x_scale) >> 6);
+    int glyphHeight = (int)(FT_MulFix(face->bbox.yMax - face->bbox.yMin, face->size->metrics.y_scale) >> 6);
+    cellSize = std::max(glyphWidth, glyphHeight) + 3;
+    if (mode == DISTANCE_FIELD) cellSize += 2 * SDF_SPREAD;
+    if (cellSize > PAGE_SIZE) cellSize = PAGE_SIZE;
+    columns = PAGE_SIZE / cellSize;
+    cellCount = columns * columns;
+    cellOwner.assign(cellCount, std::uint32_t(NO_GLYPH));
+    cellLastUsed.assign(cellCount, 0);
+    cellEvictedAt.assign(cellCount, 0);
+    cellBuffer.resize((size_t)cellSize * cellSize);
+
+    std::vector<unsigned char> empty((size_t)PAGE_SIZE * PAGE_SIZE, 0);
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, PAGE_SIZE, PAGE_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+Font::~Font() {
+    glDeleteTextures(1, &texture);
+    FT_Done_Face(face);
+}
+
+void Font::beginBatch() {
+    ++batch;
+}
+
+bool Font::cellsEvictedSince(const std::vector<int>& cells, unsigned long long evictionCount) const {
+    if (evictions == evictionCount) return false;
+    for (int cell : cells) {
+        if (cellEvictedAt[cell] > evictionCount) return true;
+    }
+    return false;
+}
+
+void Font::touchCells(const std::vector<int>& cells) {
+    for (int cell : cells) cellLastUsed[cell] = batch;
+}
+
+Character& Font::slot(std::uint32_t codepoint) {
+    return codepoint < ASCII_COUNT ? ascii[codepoint] : others[codepoint];
+}
+
+// A free cell, or the least recently used one; -1 if that one is still
+// needed by the current batch
+int Font::takeCell(bool& batchFull) {
+    if (cellsUsed < cellCount) return cellsUsed++;
+
+    int oldest = 0;
+    for (int cell = 1; cell < cellCount; ++cell) {
+        if (cellLastUsed[cell] < cellLastUsed[oldest]) oldest = cell;
+    }
+    if (cellLastUsed[oldest] == batch) {
+        batchFull = true;
+        return -1;
+    }
+
+    std::uint32_t owner = cellOwner[oldest];
+    if (owner < ASCII_COUNT) ascii[owner].Loaded = false;
+    else others.erase(owner);
+    cellEvictedAt[oldest] = ++evictions;
+    return oldest;
+}
+
+const Character* Font::getGlyph(std::uint32_t codepoint, bool& batchFull) {
+    batchFull = false;
+
+    Character& cached = slot(codepoint);
+    if (cached.Loaded) {
+        if (cached.Cell >= 0) cellLastUsed[cached.Cell] = batch;
+        return &cached;
+    }
+
+    if (!rasterizeGlyph(face, codepoint, mode == DISTANCE_FIELD ? SDF_SPREAD : 0, glyphBuffer)) {
+        std::cerr << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
+        if (codepoint >= ASCII_COUNT) others.erase(codepoint);
+        return nullptr;
+    }
+    return store(glyphBuffer, batchFull);
+}
+
+int Font::addGlyphs(const std::vector<GlyphBitmap>& glyphs) {
+    int added = 0;
+    for (const GlyphBitmap& glyph : glyphs) {
+        if (slot(glyph.codepoint).Loaded) continue;
+        bool batchFull;
+        if (store(glyph, batchFull)) ++added;
+        else if (batchFull) break;
+    }
+    return added;
+}
+
+// Puts a rendered glyph in a cell of the page
+const Character* Font::store(const GlyphBitmap& bitmap, bool& batchFull) {
+    batchFull = false;
+    std::uint32_t codepoint = bitmap.codepoint;
+    Character glyph = {};
+    glyph.Bearing = glm::ivec2(bitmap.bearingX, bitmap.bearingY);
+    glyph.Advance = (GLuint)bitmap.advance;
+    glyph.Cell = -1;
+    glyph.Loaded = true;
+
+    if (!bitmap.pixels.empty()) {
+        glyph.Size = glm::ivec2(std::min(bitmap.width, cellSize - 2), std::min(bitmap.rows, cellSize - 2));
+
+        int cell = takeCell(batchFull);
+        if (cell < 0) {
+            if (codepoint >= ASCII_COUNT) others.erase(codepoint);
+            return nullptr;
+        }
+        glyph.Cell = cell;
+        cellOwner[cell] = codepoint;
+        cellLastUsed[cell] = batch;
+
+        // Whole cell at once, so nothing of the previous glyph is left to bleed in
+        std::fill(cellBuffer.begin(), cellBuffer.end(), 0);
+        for (int row = 0; row < glyph.Size.y; ++row) {
+            const unsigned char* source = bitmap.pixels.data() + (size_t)row * bitmap.width;
+            std::copy(source, source + glyph.Size.x, cellBuffer.begin() + (size_t)(row + 1) * cellSize + 1);
+        }
+        int cellX = (cell % columns) * cellSize;
+        int cellY = (cell / columns) * cellSize;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, cellX, cellY, cellSize, cellSize, GL_RED, GL_UNSIGNED_BYTE, cellBuffer.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glyph.UvMin = glm::vec2((float)(cellX + 1) / PAGE_SIZE, (float)(cellY + 1) / PAGE_SIZE);
+        glyph.UvMax = glm::vec2((float)(cellX + 1 + glyph.Size.x) / PAGE_SIZE, (float)(cellY + 1 + glyph.Size.y) / PAGE_SIZE);
+    }
+
+    Character& stored = slot(codepoint);
+    stored = glyph;
+    return &stored;
+}
+
+unsigned int Font::getTexture() const {
+    return texture;
+}
+
+int Font::getPixelSize() const {
+    return pixelSize;
+}
+
+Font::Mode Font::getMode() const {
+    return mode;
+}
+
+int Font::getCellCount() const {
+    return cellCount;
+}
+
+int Font::getCellsUsed() const {
+    return cellsUsed;
+}
+
+unsigned long long Font::getEvictionCount() const {
+    return evictions;
+}
+
+FontCache::FontCache() : library(nullptr) {
+    if (FT_Init_FreeType(&library)) {
+        std::cerr << "ERROR::FREETYPE: Could not initialize FreeType Library" << std::endl;
+        library = nullptr;
+    }
+}
+
+FontCache::~FontCache() {
+    fonts.clear();
+    shaders.clear();
+    if (library) FT_Done_FreeType(library);
+}
+
+Font* FontCache::getFont(const std::string& path, int pixelSize, Font::Mode mode) {
+    auto key = std::make_tuple(path, pixelSize, (int)mode);
+    auto found = fonts.find(key);
+    if (found != fonts.end()) return found->second.get();
+    if (!library) return nullptr;
+
+    FT_Face face;
+    if (openFontFace(library, path, &face)) {
+        std::cerr << "ERROR::FREETYPE: Failed to load font: " << path << std::endl;
+        return nullptr;
+    }
+    Font* font = new Font(face, pixelSize, mode);
+    fonts[key] = std::unique_ptr<Font>(font);
+    return font;
+}
+
+size_t FontCache::getFontCount() const {
+    return fonts.size();
+}
+
+// A program that fails to load is still cached (and draws nothing), so the
+// error is reported once
+ShaderProgram* FontCache::getShader(const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
+    auto key = std::make_pair(vertexShaderPath, fragmentShaderPath);
+    auto found = shaders.find(key);
+    if (found != shaders.end()) return found->second.get();
+
+    ShaderProgram* shader = new ShaderProgram();
+    shaders[key] = std::unique_ptr<ShaderProgram>(shader);
+    shader->loadFiles(vertexShaderPath, fragmentShaderPath);
+    return shader;
+}
@@ -0,0 +1,127 @@
+#ifndef FONTCACHE_H
+#define FONTCACHE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "GlyphRasterizer.h"
+#include "ShaderProgram.h"
+
+// A glyph's place in its font's atlas page and its metrics in pixels
+struct Character {
+    glm::vec2 UvMin;        // Top-left of the glyph in the atlas
+    glm::vec2 UvMax;        // Bottom-right
+    glm::ivec2 Size;
+    glm::ivec2 Bearing;
+    GLuint Advance;         // 1/64 pixels
+    int Cell;               // Atlas cell holding the bitmap, -1 if it has none (space)
+    bool Loaded;
+};
+
+// One font at one pixel size. Glyphs are rasterized the first time they are
+// asked for and stored in a square grid of cells on a single atlas page;
+// when every cell is taken, the least recently used glyph gives up its cell.
+//
+// A DISTANCE_FIELD font stores, instead of coverage, the distance to the
+// glyph outline (0.5 on the edge, SDF_SPREAD pixels to 0 or 1), so one
+// SDF_SIZE bake stays sharp drawn at any size with text_sdf.frag.
+class Font {
+public:
+    enum Mode { BITMAP, DISTANCE_FIELD };
+
+    static const int PAGE_SIZE = 1024;
+    static const int SDF_SIZE = 48;         // Pixel size distance fields are baked at
+    static const int SDF_SPREAD = 6;        // Pixels of distance either side of the edge
+
+    ~Font();
+
+    // Everything asked for between two beginBatch calls may be drawn
+    // together, so none of it is evicted in between
+    void beginBatch();
+
+    // For text laid out in an earlier batch (TextLabel): whether any of its
+    // cells has changed glyph since the font's eviction count was
+    // evictionCount, and marking them drawn in the current batch so its
+    // glyphs are not the first evicted
+    bool cellsEvictedSince(const std::vector<int>& cells, unsigned long long evictionCount) const;
+    void touchCells(const std::vector<int>& cells);
+
+    // nullptr with batchFull set when the page is full of glyphs from the
+    // current batch: draw what you have, call beginBatch and ask again
+    const Character* getGlyph(std::uint32_t codepoint, bool& batchFull);
+
+    // Stores glyphs rendered ahead of time (rasterizeGlyphs from the same
+    // file at this font's pixel size, with SDF_SPREAD for a distance field
+    // font); ones already loaded are skipped. Returns how many were added.
+    int addGlyphs(const std::vector<GlyphBitmap>& glyphs);
+
+    unsigned int getTexture() const;
+    int getPixelSize() const;
+    Mode getMode() const;
+    int getCellCount() const;
+    int getCellsUsed() const;
+    unsigned long long getEvictionCount() const;
+
+private:
+    friend class FontCache;
+    Font(FT_Face face, int pixelSize, Mode mode);
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
+    static const int ASCII_COUNT = 128;
+    static const std::uint32_t NO_GLYPH = 0xFFFFFFFFu;
+
+    FT_Face face;
+    int pixelSize;
+    Mode mode;
+    unsigned int texture = 0;
+    int cellSize = 0, columns = 0, cellCount = 0, cellsUsed = 0;
+    Character ascii[ASCII_COUNT] = {};          // Flat lookup for the common case
+    std::unordered_map<std::uint32_t, Character> others;
+    std::vector<std::uint32_t> cellOwner;       // Code point in each cell
+    std::vector<std::uint64_t> cellLastUsed;    // Batch that last drew it
+    std::vector<unsigned long long> cellEvictedAt;  // Eviction count when it last changed glyph
+    std::vector<unsigned char> cellBuffer;      // Staging for one cell upload
+    GlyphBitmap glyphBuffer;                    // The glyph being loaded
+    std::uint64_t batch = 1;
+    unsigned long long evictions = 0;
+
+    Character& slot(std::uint32_t codepoint);
+    int takeCell(bool& batchFull);
+    const Character* store(const GlyphBitmap& bitmap, bool& batchFull);
+};
+
+// Fonts and text shaders shared by every TextRenderer. A font file at a pixel
+// size and mode is opened once however many renderers use it, and a shader pair
+// is compiled once. Create it after the GL context and keep it alive for as
+// long as any renderer that uses it.
+class FontCache {
+public:
+    FontCache();
+    ~FontCache();
+
+    // nullptr if the file cannot be loaded
+    Font* getFont(const std::string& path, int pixelSize, Font::Mode mode = Font::BITMAP);
+    ShaderProgram* getShader(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
+
+    size_t getFontCount() const;
+
+private:
+    FontCache(const FontCache&) = delete;
+    FontCache& operator=(const FontCache&) = delete;
+
+    FT_Library library;
+    std::map<std::tuple<std::string, int, int>, std::unique_ptr<Font>> fonts;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<ShaderProgram>> shaders;
+};
+
+#endif // FONTCACHE_H
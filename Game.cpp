@@ -0,0 +1,211 @@
+#include "Game.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+static const std::uint64_t SHAKE_STREAM = 1;
+static const float BOARD_Z = 0.1f;          // The dartboard is drawn at z = 0.1
+static const float VIEWPORT_SIZE = 800.0f;  // Window is 800x800
+
+// Alt snaps the camera to this zoom and makes the hand shake harder
+static const float STEADY_ZOOM_LEVEL = 1.1f;
+static const float ZOOM_EPSILON = 0.01f;
+
+Game::Game(std::uint64_t seed, const X01Rules& rules) : state(), rules(rules), accumulator(0.0f) {
+    names[0] = "Player 1";
+    names[1] = "Player 2";
+    state.seed = seed;
+    init();
+}
+
+void Game::init() {
+    std::uint64_t seed = state.seed;
+    state = GameState();
+    state.seed = seed;
+    for (PlayerState& player : state.players) {
+        player.score = 0;
+        player.dartsLeft = 3;
+        player.turnStartScore = 0;
+    }
+    state.roundNumber = 1;
+    state.winner = -1;
+    state.phase = GameState::AIMING;
+    state.zoomLevel = 1.0f;
+    state.targetZoomLevel = 1.0f;
+
+    shakeRandom.seed(seed, SHAKE_STREAM);
+    input = GameInput();
+    accumulator = 0.0f;
+}
+
+void Game::update(float dt) {
+    // Never try to catch up more than a quarter second after a stall
+    accumulator = std::min(accumulator + dt, 0.25f);
+    const float tickLength = 1.0f / TICKS_PER_SECOND;
+    while (accumulator >= tickLength) {
+        step();
+        accumulator -= tickLength;
+    }
+}
+
+void Game::handleInput(const GameInput& newInput) {
+    input = newInput;
+}
+
+void Game::step() {
+    const GameInput& previous = state.previousInput;
+
+    if (input.pauseHeld && !previous.pauseHeld) state.paused = !state.paused;
+
+    // Zoom
+    if (input.zoomInHeld) state.targetZoomLevel = std::max(0.1f, state.targetZoomLevel - 0.1f);
+    if (input.zoomOutHeld) state.targetZoomLevel = std::min(2.0f, state.targetZoomLevel + 0.1f);
+    state.zoomLevel = input.steadyHeld ? STEADY_ZOOM_LEVEL : state.targetZoomLevel;
+
+    if (!state.paused) updateCrosshair();
+
+    switch (state.phase) {
+    case GameState::AIMING:
+        if (input.throwHeld && !previous.throwHeld && !state.paused && state.players[state.activePlayer].dartsLeft > 0) {
+            throwDart();
+        }
+        break;
+    case GameState::CLEARING:
+        if (--state.clearTicks <= 0) switchTurn();
+        break;
+    case GameState::FINISHED:
+        break;
+    }
+
+    state.previousInput = input;
+    ++state.tick;
+}
+
+void Game::updateCrosshair() {
+    // Shake depends only on the seed and the tick, so replays and rollbacks
+    // see the same hand
+    bool steady = std::fabs(state.zoomLevel - STEADY_ZOOM_LEVEL) < ZOOM_EPSILON;
+    float shakeAmount = steady ? 0.06f : 0.02f;
+    shakeRandom.setPosition(state.tick * 4);
+    float shakeX = shakeRandom.uniform(-1.0f, 1.0f) * shakeAmount;
+    float shakeY = shakeRandom.uniform(-1.0f, 1.0f) * shakeAmount;
+
+    state.crosshairX = std::min(1.0f, std::max(-1.0f, input.aimX + shakeX));
+    state.crosshairY = std::min(1.0f, std::max(-1.0f, input.aimY + shakeY));
+}
+
+void Game::throwDart() {
+    glm::vec2 board = crosshairToBoard(state.crosshairX, state.crosshairY);
+    landDart(board.x, board.y);
+}
+
+// Replays skip the ticks in between: the turn changes as soon as the next
+// player's first dart arrives
+void Game::replayThrow(const ThrowState& recorded) {
+    if (state.phase == GameState::FINISHED) return;
+    if (state.phase == GameState::CLEARING || recorded.player != state.activePlayer) switchTurn();
+
+    state.tick = recorded.tick;
+    state.crosshairX = recorded.crosshairX;
+    state.crosshairY = recorded.crosshairY;
+    landDart(recorded.boardX, recorded.boardY);
+}
+
+void Game::landDart(float boardX, float boardY) {
+    PlayerState& player = state.players[state.activePlayer];
+    BoardSegment hit = scorer.segment(boardX, boardY);
+
+    int left;
+    X01Rules::Result result = rules.apply(rules.startScore - player.score, hit, left);
+    if (result == X01Rules::BUST) {
+        player.score = player.turnStartScore;
+        player.dartsLeft = 0;  // A bust ends the turn
+    }
+    else {
+        player.score = rules.startScore - left;
+        --player.dartsLeft;
+    }
+
+    if (state.dartCount < 3) {
+        state.dartX[state.dartCount] = boardX;
+        state.dartY[state.dartCount] = boardY;
+        ++state.dartCount;
+    }
+
+    state.lastThrow = { state.tick, state.activePlayer, state.crosshairX, state.crosshairY,
+        boardX, boardY, hit.score(), player.dartsLeft, result };
+    ++state.throwCount;
+
+    if (result == X01Rules::FINISHED) {
+        state.phase = GameState::FINISHED;
+        state.winner = state.activePlayer;
+    }
+    else if (player.dartsLeft == 0) {
+        state.phase = GameState::CLEARING;
+        state.clearTicks = CLEAR_TICKS;
+    }
+}
+
+void Game::switchTurn() {
+    state.dartCount = 0;
+    state.activePlayer ^= 1;
+    if (state.activePlayer == 0) ++state.roundNumber;
+
+    PlayerState& player = state.players[state.activePlayer];
+    player.dartsLeft = 3;
+    player.turnStartScore = player.score;
+    state.phase = GameState::AIMING;
+}
+
+glm::mat4 Game::getProjection() const {
+    float fov = 45.0f / state.zoomLevel;
+    return glm::perspective(glm::radians(fov), 1.0f, 0.1f, 100.0f);
+}
+
+glm::mat4 Game::getView() const {
+    glm::vec3 cameraPos(0.0f, 0.0f, 2.0f / state.zoomLevel);
+    return glm::lookAt(cameraPos, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+// Cast a ray through the crosshair and intersect it with the board plane
+glm::vec2 Game::crosshairToBoard(float x, float y) const {
+    float windowX = (x * 0.5f + 0.5f) * VIEWPORT_SIZE;
+    float windowY = (y * 0.5f + 0.5f) * VIEWPORT_SIZE;
+    glm::vec4 viewport(0.0f, 0.0f, VIEWPORT_SIZE, VIEWPORT_SIZE);
+    glm::mat4 projection = getProjection();
+    glm::mat4 view = getView();
+    glm::vec3 nearPoint = glm::unProject(glm::vec3(windowX, windowY, 0.0f), view, projection, viewport);
+    glm::vec3 farPoint = glm::unProject(glm::vec3(windowX, windowY, 1.0f), view, projection, viewport);
+
+    float t = (BOARD_Z - nearPoint.z) / (farPoint.z - nearPoint.z);
+    glm::vec3 point = nearPoint + t * (farPoint - nearPoint);
+    return glm::vec2(point.x, point.y);
+}
+
+const GameState& Game::getState() const {
+    return state;
+}
+
+void Game::setState(const GameState& newState) {
+    if (newState.seed != state.seed) shakeRandom.seed(newState.seed, SHAKE_STREAM);
+    state = newState;
+    input = state.previousInput;
+    accumulator = 0.0f;
+}
+
+const X01Rules& Game::getRules() const {
+    return rules;
+}
+
+const std::string& Game::getPlayerName(int player) const {
+    return names[player];
+}
+
+int Game::getRemaining(int player) const {
+    return rules.startScore - state.players[player].score;
+}
+
+float Game::getTimerSeconds() const {
+    if (state.phase != GameState::CLEARING) return -1.0f;
+    return (float)state.clearTicks / TICKS_PER_SECOND;
+}
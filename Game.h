@@ -1,29 +1,111 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "Player.h"
-#include "Dartboard.h"
-#include "Crosshair.h"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <glm/glm.hpp>
+#include "BoardScorer.h"
+#include "Random.h"
+#include "ThrowState.h"
+#include "X01Rules.h"
 
-class Game {
-private:
-    Player player1;
-    Player player2;
-    Dartboard dartboard;
-    Crosshair crosshair;
+// What the player is doing this tick, already translated from the window
+// system. Buttons are "held" states; the game finds the press edges itself.
+struct GameInput {
+    float aimX = 0.0f;          // Cursor in NDC, before shake
+    float aimY = 0.0f;
+    bool throwHeld = false;     // Left mouse button
+    bool pauseHeld = false;     // Esc
+    bool steadyHeld = false;    // Alt: zoom in, but the hand shakes more
+    bool zoomInHeld = false;    // Up arrow
+    bool zoomOutHeld = false;   // Down arrow
+};
+
+struct PlayerState {
+    int score;                  // Counts up to the rules' start score
+    int dartsLeft;
+    int turnStartScore;
+};
+
+// The whole match as plain data: copying it is a snapshot, assigning it back
+// is a rollback
+struct GameState {
+    enum Phase : std::uint8_t {
+        AIMING,         // Active player may throw
+        CLEARING,       // Turn over, darts stay on the board for a moment
+        FINISHED        // Someone reached the target score
+    };
 
-    Player* activePlayer;
-    bool isPaused;
+    std::uint64_t seed;         // Crosshair shake is a pure function of (seed, tick)
+    std::uint64_t tick;
+    PlayerState players[2];
+    int activePlayer;
     int roundNumber;
+    int winner;                 // -1 until FINISHED
+    Phase phase;
+    bool paused;
+    int clearTicks;             // Ticks left in CLEARING
 
-public:
-    Game();                // Constructor
-    void init();           // Initialize the game
-    void update(float dt); // Update game logic
-    void render();         // Render the game
-    void handleInput(int key, int action); // Handle player input
-    void switchTurn();     // Switch active player
+    float crosshairX, crosshairY;
+    float zoomLevel;            // Camera zoom actually used this tick
+    float targetZoomLevel;      // Zoom chosen with the arrow keys
+
+    int dartCount;              // Darts on the board this turn
+    float dartX[3], dartY[3];
+    std::uint64_t throwCount;   // Increases once per throw; compare to spot new throws
+    ThrowState lastThrow;
+
+    GameInput previousInput;    // For press edges
 };
 
-#endif
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must stay plain data");
+
+// Match logic for two players, advanced on a fixed timestep and independent
+// of rendering. The window loop feeds it input and reads its state; a
+// headless runner can call step() as fast as it likes.
+class Game {
+public:
+    static const int TICKS_PER_SECOND = 60;
+
+    Game(std::uint64_t seed = 0, const X01Rules& rules = X01Rules::house());
+
+    void init();                            // Start a new match (same seed)
+    void update(float dt);                  // Run however many ticks dt covers
+    void step();                            // Run exactly one tick
+    void handleInput(const GameInput& input); // Input for the coming ticks
+    void switchTurn();                      // Hand the board to the other player
+    void replayThrow(const ThrowState& recorded); // Land a logged dart exactly where it went
+
+    const GameState& getState() const;
+    void setState(const GameState& state);  // Roll back or jump to a snapshot
+    const X01Rules& getRules() const;
+    const std::string& getPlayerName(int player) const;
+    int getRemaining(int player) const;     // Score still needed
+    // Seconds until the game changes by itself (the end of CLEARING), apart
+    // from the crosshair shake; negative when nothing is scheduled
+    float getTimerSeconds() const;
+
+    // Camera for the current zoom level; the same matrices turn a crosshair
+    // position into a point on the board
+    glm::mat4 getProjection() const;
+    glm::mat4 getView() const;
+
+private:
+    static const int CLEAR_TICKS = TICKS_PER_SECOND;   // One second
+
+    GameState state;
+    GameInput input;
+    X01Rules rules;
+    BoardScorer scorer;
+    Random shakeRandom;
+    std::string names[2];
+    float accumulator;
+
+    void updateCrosshair();
+    void throwDart();
+    void landDart(float boardX, float boardY);
+    glm::vec2 crosshairToBoard(float x, float y) const;
+};
 
+#endif // GAME_H
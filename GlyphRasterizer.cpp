@@ -0,0 +1,126 @@
+#include "GlyphRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include "AssetPack.h"
+
+// Squared distance from each sample to the nearest zero of f, in place
+// (Felzenszwalb & Huttenlocher's lower envelope of parabolas). v, z and d
+// are scratch space for n, n + 1 and n values.
+static void distanceTransform1D(float* f, int stride, int n, int* v, float* z, float* d) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INFINITY;
+    z[1] = INFINITY;
+    for (int q = 1; q < n; ++q) {
+        float s;
+        do {
+            int r = v[k];
+            s = ((f[q * stride] + q * q) - (f[r * stride] + r * r)) / (2.0f * (q - r));
+        } while (s <= z[k] && --k >= 0);
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INFINITY;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        int r = v[k];
+        d[q] = f[r * stride] + (q - r) * (q - r);
+    }
+    for (int q = 0; q < n; ++q) f[q * stride] = d[q];
+}
+
+static void distanceTransform2D(std::vector<float>& grid, int width, int height) {
+    int n = std::max(width, height);
+    std::vector<int> v(n);
+    std::vector<float> z(n + 1), d(n);
+    for (int x = 0; x < width; ++x) distanceTransform1D(&grid[x], width, height, v.data(), z.data(), d.data());
+    for (int y = 0; y < height; ++y) distanceTransform1D(&grid[(size_t)y * width], 1, width, v.data(), z.data(), d.data());
+}
+
+// Signed distance field of a coverage bitmap with spread pixels of margin.
+// Partly covered pixels seed the transform with their sub-pixel distance to
+// the edge, so the outline keeps the antialiased bitmap's precision.
+static void buildDistanceField(const FT_Bitmap& bitmap, int spread, int width, int height, std::vector<unsigned char>& field) {
+    const float far = 1e20f;
+    size_t count = (size_t)width * height;
+    std::vector<float> outside(count, far), inside(count, 0.0f);
+    for (int row = 0; row < (int)bitmap.rows; ++row) {
+        for (int col = 0; col < (int)bitmap.width; ++col) {
+            float coverage = bitmap.buffer[row * bitmap.pitch + col] / 255.0f;
+            size_t i = (size_t)(row + spread) * width + col + spread;
+            if (coverage >= 1.0f) {
+                outside[i] = 0.0f;
+                inside[i] = far;
+            }
+            else if (coverage > 0.0f) {
+                float toEdge = 0.5f - coverage;
+                outside[i] = toEdge > 0.0f ? toEdge * toEdge : 0.0f;
+                inside[i] = toEdge < 0.0f ? toEdge * toEdge : 0.0f;
+            }
+        }
+    }
+    distanceTransform2D(outside, width, height);
+    distanceTransform2D(inside, width, height);
+
+    field.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        float distance = std::sqrt(outside[i]) - std::sqrt(inside[i]);    // Positive outside the glyph
+        float value = 0.5f - distance / (2.0f * spread);
+        field[i] = (unsigned char)std::lround(std::min(std::max(value, 0.0f), 1.0f) * 255.0f);
+    }
+}
+
+FT_Error openFontFace(FT_Library library, const std::string& path, FT_Face* face) {
+    AssetView view;
+    if (findAsset(path, view)) return FT_New_Memory_Face(library, view.data, (FT_Long)view.size, 0, face);
+    return FT_New_Face(library, path.c_str(), 0, face);
+}
+
+bool rasterizeGlyph(FT_Face face, std::uint32_t codepoint, int spread, GlyphBitmap& glyph) {
+    if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER)) return false;
+
+    const FT_Bitmap& bitmap = face->glyph->bitmap;
+    glyph.codepoint = codepoint;
+    glyph.width = bitmap.width;
+    glyph.rows = bitmap.rows;
+    glyph.bearingX = face->glyph->bitmap_left;
+    glyph.bearingY = face->glyph->bitmap_top;
+    glyph.advance = (unsigned int)face->glyph->advance.x;
+    glyph.pixels.clear();
+    if (bitmap.width == 0 || bitmap.rows == 0) return true;
+
+    if (spread > 0) {
+        glyph.width += 2 * spread;
+        glyph.rows += 2 * spread;
+        glyph.bearingX -= spread;
+        glyph.bearingY += spread;
+        buildDistanceField(bitmap, spread, glyph.width, glyph.rows, glyph.pixels);
+    }
+    else {
+        glyph.pixels.resize((size_t)glyph.width * glyph.rows);
+        for (int row = 0; row < glyph.rows; ++row) {
+            const unsigned char* source = bitmap.buffer + row * bitmap.pitch;
+            std::copy(source, source + glyph.width, glyph.pixels.begin() + (size_t)row * glyph.width);
+        }
+    }
+    return true;
+}
+
+std::vector<GlyphBitmap> rasterizeGlyphs(const std::string& fontPath, int pixelSize, int spread, std::uint32_t first, std::uint32_t last) {
+    std::vector<GlyphBitmap> glyphs;
+    FT_Library library;
+    if (FT_Init_FreeType(&library)) return glyphs;
+    FT_Face face;
+    if (openFontFace(library, fontPath, &face) == 0) {
+        FT_Set_Pixel_Sizes(face, 0, pixelSize);
+        for (std::uint32_t codepoint = first; codepoint <= last; ++codepoint) {
+            GlyphBitmap glyph;
+            if (rasterizeGlyph(face, codepoint, spread, glyph)) glyphs.push_back(std::move(glyph));
+        }
+        FT_Done_Face(face);
+    }
+    FT_Done_FreeType(library);
+    return glyphs;
+}
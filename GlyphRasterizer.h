@@ -0,0 +1,34 @@
+#ifndef GLYPHRASTERIZER_H
+#define GLYPHRASTERIZER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+// A rendered glyph before it goes into an atlas; pixels are width * rows
+// bytes, tightly packed, top row first
+struct GlyphBitmap {
+    std::uint32_t codepoint = 0;
+    int width = 0, rows = 0;
+    int bearingX = 0, bearingY = 0;
+    unsigned int advance = 0;       // 1/64 pixels
+    std::vector<unsigned char> pixels;
+};
+
+// Opens a font from the mounted AssetPack, reading it in place, or else
+// from disk; 0 on success like FT_New_Face
+FT_Error openFontFace(FT_Library library, const std::string& path, FT_Face* face);
+
+// Renders a glyph with the face at its current pixel size. With spread > 0
+// the bitmap is a signed distance field of the outline (0.5 on the edge,
+// spread pixels to 0 or 1) with spread pixels of margin around it.
+bool rasterizeGlyph(FT_Face face, std::uint32_t codepoint, int spread, GlyphBitmap& glyph);
+
+// Renders the code points first..last of a font file with a FreeType library
+// of its own, so it can run on any thread. Code points the font cannot
+// render are left out; empty if the file cannot be opened.
+std::vector<GlyphBitmap> rasterizeGlyphs(const std::string& fontPath, int pixelSize, int spread, std::uint32_t first, std::uint32_t last);
+
+#endif // GLYPHRASTERIZER_H
@@ -0,0 +1,91 @@
+#include "HeadlessRunner.h"
+#include "Random.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+HeadlessRunner::HeadlessRunner(ScriptedInput& input, const X01Rules& rules) : input(input), rules(rules), throwLog(nullptr) {
+}
+
+void HeadlessRunner::setThrowLog(ThrowLogWriter* log) {
+    throwLog = log;
+}
+
+HeadlessReport HeadlessRunner::run(unsigned long long matches, std::uint64_t seed, unsigned long long maxTicksPerMatch) {
+    HeadlessReport report;
+    std::uint64_t seedState = seed;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned long long match = 0; match < matches; ++match) {
+        Game game(Random::splitMix64(seedState), rules);
+        // A fresh aim stream per match, or every match replays the same
+        // throws and the seats see different luck
+        input.restart(Random::splitMix64(seedState));
+
+        unsigned long long ticks = 0;
+        std::uint64_t throws = 0;
+        while (game.getState().phase != GameState::FINISHED && ticks < maxTicksPerMatch) {
+            game.handleInput(input.next());
+            game.step();
+            ++ticks;
+            // A throw needs a press edge, so there is at most one per tick
+            if (throwLog && game.getState().throwCount != throws) {
+                throws = game.getState().throwCount;
+                throwLog->append(game.getState().lastThrow);
+            }
+        }
+
+        report.ticks += ticks;
+        report.throws += game.getState().throwCount;
+        if (game.getState().phase != GameState::FINISHED) ++report.unfinished;
+        ++report.matches;
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void HeadlessRunner::printReport(const HeadlessReport& report) {
+    std::cout << report.matches << " matches in " << report.seconds << " s" << std::endl;
+    std::cout << "  " << report.ticks << " ticks (" << (unsigned long long)report.ticksPerSecond() << " ticks/s, "
+        << report.ticksPerSecond() / Game::TICKS_PER_SECOND << "x real time)" << std::endl;
+    std::cout << "  " << report.throws << " throws (" << (unsigned long long)report.throwsPerSecond() << " throws/s)" << std::endl;
+    if (report.unfinished) std::cout << "  " << report.unfinished << " matches hit the tick limit" << std::endl;
+}
+
+int runHeadless(int argc, char** argv) {
+    unsigned long long seed = 1;
+    unsigned long long matches = 100;
+    unsigned long long maxTicks = 60ull * 60 * 60 * Game::TICKS_PER_SECOND;   // An hour of play
+    const char* scriptPath = nullptr;
+    const char* logPath = nullptr;
+    X01Rules rules = X01Rules::house();
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--headless")) continue;
+        else if (!std::strcmp(argv[i], "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--matches") && hasValue) matches = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--max-ticks") && hasValue) maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--script") && hasValue) scriptPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--log") && hasValue) logPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--double-out")) rules = X01Rules::tournament();
+        else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    ScriptedInput input(seed);
+    if (scriptPath && !input.load(scriptPath)) return 1;
+
+    ThrowLogWriter throwLog;
+    if (logPath && !throwLog.open(logPath)) return 1;
+
+    HeadlessRunner runner(input, rules);
+    if (logPath) runner.setThrowLog(&throwLog);
+    HeadlessReport report = runner.run(matches, seed, maxTicks);
+    HeadlessRunner::printReport(report);
+    return report.unfinished ? 2 : 0;
+}
@@ -0,0 +1,45 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <cstdint>
+#include "Game.h"
+#include "ScriptedInput.h"
+#include "ThrowLog.h"
+#include "X01Rules.h"
+
+struct HeadlessReport {
+    unsigned long long matches = 0;
+    unsigned long long unfinished = 0;      // Matches stopped at the tick limit
+    unsigned long long ticks = 0;
+    unsigned long long throws = 0;
+    double seconds = 0.0;
+
+    double ticksPerSecond() const { return seconds > 0.0 ? ticks / seconds : 0.0; }
+    double throwsPerSecond() const { return seconds > 0.0 ? throws / seconds : 0.0; }
+};
+
+// The game loop without a window: scripted input goes in, Game::step() runs
+// back to back with no frame pacing, and nothing is drawn. Match i is played
+// with game and aim seeds derived from (seed, i), so a run is reproducible.
+class HeadlessRunner {
+public:
+    HeadlessRunner(ScriptedInput& input, const X01Rules& rules = X01Rules::house());
+
+    HeadlessReport run(unsigned long long matches, std::uint64_t seed, unsigned long long maxTicksPerMatch);
+
+    void setThrowLog(ThrowLogWriter* log);  // Append every throw to log (nullptr: don't)
+
+    static void printReport(const HeadlessReport& report);
+
+private:
+    ScriptedInput& input;
+    X01Rules rules;
+    ThrowLogWriter* throwLog;
+};
+
+// Command line front end shared by `Sablon --headless` and tools/RunHeadless:
+//   [--seed S] [--matches N] [--script FILE] [--max-ticks T] [--double-out]
+//   [--log FILE]
+int runHeadless(int argc, char** argv);
+
+#endif // HEADLESSRUNNER_H
@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : bytes(nullptr), length(0) {
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const char* path) {
+    close();
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+
+    bytes = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!bytes) {
+        close();
+        return false;
+    }
+    length = (std::size_t)fileSize.QuadPart;
+#else
+    int descriptor = ::open(path, O_RDONLY);
+    if (descriptor < 0) return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+        ::close(descriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (std::size_t)info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+
+    bytes = static_cast<const unsigned char*>(view);
+    length = (std::size_t)info.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    bytes = nullptr;
+    length = 0;
+}
+
+bool MappedFile::isOpen() const {
+    return bytes != nullptr;
+}
+
+const unsigned char* MappedFile::data() const {
+    return bytes;
+}
+
+std::size_t MappedFile::size() const {
+    return length;
+}
@@ -0,0 +1,33 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+
+// Read-only memory mapping of a whole file. The operating system pages the
+// contents in on first touch, so opening even a large file is immediate and
+// nothing is copied into the process heap.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const;
+    const unsigned char* data() const;
+    std::size_t size() const;
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* bytes;
+    std::size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,130 @@
+#include "MatchSimulator.h"
+#include "Random.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+MatchSimulator::MatchSimulator(const SimulatedThrower& first, const SimulatedThrower& second, const X01Rules& rules)
+    : rules(rules), grid(scorer) {
+    throwers[0] = first;
+    throwers[1] = second;
+
+    for (int player = 0; player < 2; ++player) {
+        if (player == 1 && throwers[1].sigma == throwers[0].sigma) {
+            tables[1] = tables[0];
+            continue;
+        }
+        tables[player] = std::make_shared<CheckoutTable>();
+        tables[player]->build(rules, throwers[player].sigma);
+    }
+
+    for (int code = 0; code < ScoreGrid::SEGMENT_CODES; ++code) {
+        scorer.aimPoint(ScoreGrid::decode((unsigned char)code), aimX[code], aimY[code]);
+    }
+}
+
+void MatchSimulator::runBlock(unsigned long long firstLeg, unsigned long long legCount, std::uint64_t seed, MatchReport& report) const {
+    Random generator(seed, firstLeg / LEGS_PER_BLOCK);
+
+    for (unsigned long long leg = firstLeg; leg < firstLeg + legCount; ++leg) {
+        int remaining[2] = { rules.startScore, rules.startScore };
+        int dartsThrown[2] = { 0, 0 };
+        int player = (int)(leg & 1);
+        int winner = -1;
+
+        while (winner < 0 && dartsThrown[player] < MAX_DARTS_PER_LEG) {
+            const CheckoutTable& table = *tables[player];
+            float sigma = throwers[player].sigma;
+            int turnStart = remaining[player];
+
+            for (int dartsLeft = 3; dartsLeft > 0; --dartsLeft) {
+                CheckoutHint hint = table.lookup(remaining[player], dartsLeft, turnStart);
+                unsigned char target = hint.isValid() ? ScoreGrid::encode(hint.target) : 0;
+
+                float offsetX, offsetY;
+                generator.nextGaussianPair(offsetX, offsetY);
+                float x = aimX[target] + sigma * offsetX;
+                float y = aimY[target] + sigma * offsetY;
+
+                ++dartsThrown[player];
+                int left;
+                X01Rules::Result result = rules.apply(remaining[player], grid.segment(x, y), left);
+                if (result == X01Rules::FINISHED) {
+                    winner = player;
+                    break;
+                }
+                if (result == X01Rules::BUST) {
+                    remaining[player] = turnStart;
+                    break;
+                }
+                remaining[player] = left;
+            }
+            if (winner < 0) player ^= 1;
+        }
+
+        report.darts[0] += dartsThrown[0];
+        report.darts[1] += dartsThrown[1];
+        if (winner < 0) {
+            ++report.unfinished;
+            continue;
+        }
+        ++report.wins[winner];
+        report.winningDarts += dartsThrown[winner];
+    }
+}
+
+MatchReport MatchSimulator::run(unsigned long long legs, std::uint64_t seed, unsigned threads) const {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned long long blocks = (legs + LEGS_PER_BLOCK - 1) / LEGS_PER_BLOCK;
+    threads = (unsigned)std::min<unsigned long long>(threads, std::max(1ull, blocks));
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Workers pull blocks from a shared counter; totals are plain sums, so
+    // the order blocks finish in does not matter
+    std::atomic<unsigned long long> nextBlock(0);
+    std::vector<MatchReport> partial(threads);
+    auto work = [&](unsigned worker) {
+        MatchReport local;  // Kept off the shared vector while running
+        for (unsigned long long block = nextBlock++; block < blocks; block = nextBlock++) {
+            unsigned long long firstLeg = block * LEGS_PER_BLOCK;
+            unsigned long long blockLegs = legs - firstLeg < LEGS_PER_BLOCK ? legs - firstLeg : LEGS_PER_BLOCK;
+            runBlock(firstLeg, blockLegs, seed, local);
+        }
+        partial[worker] = local;
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned worker = 1; worker < threads; ++worker) workers.emplace_back(work, worker);
+    work(0);
+    for (std::thread& thread : workers) thread.join();
+
+    MatchReport report;
+    report.legs = legs;
+    for (const MatchReport& part : partial) {
+        for (int player = 0; player < 2; ++player) {
+            report.wins[player] += part.wins[player];
+            report.darts[player] += part.darts[player];
+        }
+        report.winningDarts += part.winningDarts;
+        report.unfinished += part.unfinished;
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void MatchSimulator::printReport(const MatchReport& report) const {
+    std::cout << report.legs << " legs in " << report.seconds << " s (" << (unsigned long long)report.legsPerSecond() << " legs/s)" << std::endl;
+    for (int player = 0; player < 2; ++player) {
+        std::cout << "  " << throwers[player].name << " (sigma " << throwers[player].sigma << "): "
+            << report.winRate(player) * 100.0 << "% wins, "
+            << (report.legs ? (double)report.darts[player] / report.legs : 0.0) << " darts per leg" << std::endl;
+    }
+    std::cout << "  Winner needed " << report.averageWinningDarts() << " darts on average";
+    if (report.unfinished) std::cout << ", " << report.unfinished << " legs hit the dart limit";
+    std::cout << std::endl;
+}
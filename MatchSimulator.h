@@ -0,0 +1,59 @@
+#ifndef MATCHSIMULATOR_H
+#define MATCHSIMULATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "CheckoutTable.h"
+#include "ScoreGrid.h"
+#include "X01Rules.h"
+
+// A simulated player: aims where the checkout table says and misses by a
+// circular Gaussian error of standard deviation sigma (board units)
+struct SimulatedThrower {
+    std::string name;
+    float sigma;
+};
+
+struct MatchReport {
+    unsigned long long legs = 0;
+    unsigned long long wins[2] = { 0, 0 };
+    unsigned long long darts[2] = { 0, 0 };     // Thrown by each player over all legs
+    unsigned long long winningDarts = 0;        // Thrown by the winner of each leg
+    unsigned long long unfinished = 0;          // Legs stopped at the dart limit
+    double seconds = 0.0;
+
+    double legsPerSecond() const { return seconds > 0.0 ? legs / seconds : 0.0; }
+    double winRate(int player) const { return legs ? (double)wins[player] / legs : 0.0; }
+    double averageWinningDarts() const { return legs > unfinished ? (double)winningDarts / (legs - unfinished) : 0.0; }
+};
+
+// Plays legs of x01 between two simulated throwers on every core. Legs are
+// handed out in fixed blocks, each with its own random stream derived from
+// the seed and the block number, so a report depends only on the seed and
+// the leg count - never on the thread count or scheduling.
+class MatchSimulator {
+public:
+    MatchSimulator(const SimulatedThrower& first, const SimulatedThrower& second, const X01Rules& rules = X01Rules::house());
+
+    // Player 0 throws first in even legs, player 1 in odd legs
+    MatchReport run(unsigned long long legs, std::uint64_t seed, unsigned threads = 0) const;
+
+    void printReport(const MatchReport& report) const;
+
+private:
+    static const unsigned long long LEGS_PER_BLOCK = 4096;
+    static const int MAX_DARTS_PER_LEG = 3000;
+
+    SimulatedThrower throwers[2];
+    X01Rules rules;
+    BoardScorer scorer;
+    ScoreGrid grid;
+    std::shared_ptr<CheckoutTable> tables[2];   // Shared when both sigmas match
+    float aimX[ScoreGrid::SEGMENT_CODES];       // Aim point for each target code
+    float aimY[ScoreGrid::SEGMENT_CODES];
+
+    void runBlock(unsigned long long firstLeg, unsigned long long legCount, std::uint64_t seed, MatchReport& report) const;
+};
+
+#endif // MATCHSIMULATOR_H
@@ -1,12 +1,14 @@
 #include "Overlay.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 
 // Constructor: Initialize the shader program and overlay geometry
 Overlay::Overlay(const char* vertexShaderPath, const char* fragmentShaderPath, const char* quitButtonVertexPath, const char* quitButtonFragmentPath) 
     : resumeButton(250.0f, 250.0f, 100.0f, 100.0f) {
-    shaderProgram = createShader(vertexShaderPath, fragmentShaderPath); // General overlay shader
+    shader.loadFiles(vertexShaderPath, fragmentShaderPath); // General overlay shader
+    overlayColorLoc = shader.getUniformLocation("overlayColor");
+    if (overlayColorLoc == -1) {
+        std::cerr << "Error: Uniform 'overlayColor' not found in shader program!" << std::endl;
+    }
     setupOverlayGeometry();
 
     // Enable blending for transparency
@@ -20,7 +22,6 @@ Overlay::Overlay(const char* vertexShaderPath, const char* fragmentShaderPath, c
 Overlay::~Overlay() {
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
-    glDeleteProgram(shaderProgram);
 }
 
 // Set up VAO and VBO for a quad (used for button and other overlays)
@@ -55,76 +56,15 @@ void Overlay::setupOverlayGeometry() {
 }
 
 
-// Compile a shader from a file
-unsigned int Overlay::compileShader(GLenum type, const char* sourcePath) {
-    std::ifstream file(sourcePath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open shader file: " << sourcePath << std::endl;
-        return 0;  // Return an invalid shader
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string sourceCode = buffer.str();
-    const char* source = sourceCode.c_str();
-
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Error compiling shader: " << infoLog << std::endl;
-        glDeleteShader(shader);  // Clean up in case of failure
-        return 0;  // Return an invalid shader
-    }
-
-    return shader;
-}
-
-// Create a shader program using vertex and fragment shaders
-unsigned int Overlay::createShader(const char* vertexShaderPath, const char* fragmentShaderPath) {
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderPath);
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderPath);
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    char infoLog[512];
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        std::cerr << "Error linking shader program: " << infoLog << std::endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return program;
-}
-
-
 // Render a pause menu with an overlay
 void Overlay::renderPauseMenu() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glUseProgram(shaderProgram);
+    shader.use();
 
     // Set the overlay color for the full screen (50% transparent black)
-    GLint colorLoc = glGetUniformLocation(shaderProgram, "overlayColor");
-    if (colorLoc != -1) {
-        glUniform4f(colorLoc, 0.0f, 0.0f, 0.0f, 0.8f); // Black with 50% opacity
-    }
-    else {
-        std::cerr << "Error: Uniform 'overlayColor' not found in shader program!" << std::endl;
-    }
+    glUniform4f(overlayColorLoc, 0.0f, 0.0f, 0.0f, 0.8f); // Black with 50% opacity
 
     glBindVertexArray(VAO);
     // Render the semi-transparent overlay (covering the entire screen)
@@ -3,6 +3,7 @@
 
 #include <GL/glew.h>
 #include "Button.h"
+#include "ShaderProgram.h"
 
 class Overlay {
 public:
@@ -14,7 +15,8 @@ public:
 
 private:
     // Shader program for overlay
-    unsigned int shaderProgram;
+    ShaderProgram shader;
+    GLint overlayColorLoc = -1;
 
     // VAO and VBO for geometry (screen quad)
     unsigned int VAO, VBO;
@@ -24,12 +26,6 @@ private:
     // Setup geometry for overlay rendering (quad)
     void setupOverlayGeometry();
 
-    // Compile a shader from source file
-    unsigned int compileShader(GLenum type, const char* sourcePath);
-
-    // Create shader program using vertex and fragment shaders
-    unsigned int createShader(const char* vertexShaderPath, const char* fragmentShaderPath);
-
     // Render a full-screen textured quad (helper)
     void renderTexturedQuad(float x, float y, float width, float height);
 
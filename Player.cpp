@@ -1,9 +1,10 @@
 #include "Player.h"
 
-Player::Player(std::string name) : name(name), score(0), dartsLeft(3) {}
+Player::Player(std::string name) : name(name), score(0), dartsLeft(3), turnStartScore(0) {}
 
 void Player::resetDarts() {
     dartsLeft = 3;
+    turnStartScore = score;
 }
 
 void Player::throwDart() {
@@ -24,6 +25,10 @@ int Player::getDartsLeft() const {
     return dartsLeft;
 }
 
+int Player::getTurnStartScore() const {
+    return turnStartScore;
+}
+
 std::string Player::getName() const {
     return name;
 }
@@ -8,6 +8,7 @@ private:
     std::string name;
     int score;
     int dartsLeft;
+    int turnStartScore;
 public:
     Player(std::string name = "Player");
     void resetDarts();          // Reset darts at the start of a round
@@ -15,6 +16,7 @@ public:
     void addScore(int points);  // Add points to the player's score
     int getScore() const;       // Get player's current score
     int getDartsLeft() const;   // Get darts remaining
+    int getTurnStartScore() const; // Score before the first dart of this turn
     std::string getName() const; // Get player name
 
 };
@@ -0,0 +1,188 @@
+#include "ProgramCache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+// File layout: header, then count entries of
+// { uint64 key, uint32 format, uint32 length, length bytes }
+struct ProgramCacheHeader {
+    char magic[4];              // "DPBC"
+    std::uint32_t version;
+    std::uint64_t driverHash;
+    std::uint32_t count;
+    std::uint32_t reserved;
+};
+
+static const char PROGRAM_CACHE_MAGIC[4] = { 'D', 'P', 'B', 'C' };
+static const std::uint32_t PROGRAM_CACHE_VERSION = 1;
+
+static const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+static const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+static std::uint64_t fnv1a(std::uint64_t hash, const void* data, std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Includes the terminator, so "ab" + "c" and "a" + "bc" differ
+static std::uint64_t fnv1a(std::uint64_t hash, const char* text) {
+    return fnv1a(hash, text ? text : "", (text ? std::strlen(text) : 0) + 1);
+}
+
+ProgramCache::ProgramCache()
+    : driverHash(0), enabled(false), dirty(false), hits(0), misses(0) {}
+
+bool ProgramCache::load(const std::string& cachePath) {
+    path = cachePath;
+    entries.clear();
+    dirty = false;
+
+    GLint formats = 0;
+    if (GLEW_ARB_get_program_binary) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    enabled = formats > 0;
+    if (!enabled) {
+        std::cout << "Program binaries not supported by the driver; shaders compile every start" << std::endl;
+        return false;
+    }
+
+    driverHash = FNV_OFFSET;
+    driverHash = fnv1a(driverHash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    driverHash = fnv1a(driverHash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    driverHash = fnv1a(driverHash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ProgramCacheHeader header;
+    if (data.size() < sizeof(header)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, PROGRAM_CACHE_MAGIC, 4) != 0 || header.version != PROGRAM_CACHE_VERSION) {
+        std::cerr << "Ignoring " << path << ": not a program cache" << std::endl;
+        return false;
+    }
+    if (header.driverHash != driverHash) {
+        std::cout << "Graphics driver changed; rebuilding " << path << std::endl;
+        dirty = true;   // Rewrite without the stale entries
+        return false;
+    }
+
+    std::size_t offset = sizeof(header);
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        std::uint64_t entryKey;
+        std::uint32_t format, length;
+        if (data.size() - offset < sizeof(entryKey) + 2 * sizeof(std::uint32_t)) break;
+        std::memcpy(&entryKey, &data[offset], sizeof(entryKey));
+        std::memcpy(&format, &data[offset + 8], sizeof(format));
+        std::memcpy(&length, &data[offset + 12], sizeof(length));
+        offset += 16;
+        if (data.size() - offset < length) break;
+
+        Entry& entry = entries[entryKey];
+        entry.format = format;
+        entry.binary.assign(data.begin() + offset, data.begin() + offset + length);
+        offset += length;
+    }
+    if (entries.size() != header.count) {
+        std::cerr << path << " is truncated; keeping " << entries.size() << " of " << header.count << " programs" << std::endl;
+        dirty = true;
+    }
+    return true;
+}
+
+bool ProgramCache::save() {
+    if (!enabled || !dirty) return true;
+
+    // Written beside the old file and renamed over it, so a crash mid-write
+    // never leaves a torn cache
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write " << temporary << std::endl;
+            return false;
+        }
+
+        ProgramCacheHeader header;
+        std::memcpy(header.magic, PROGRAM_CACHE_MAGIC, 4);
+        header.version = PROGRAM_CACHE_VERSION;
+        header.driverHash = driverHash;
+        header.count = (std::uint32_t)entries.size();
+        header.reserved = 0;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& item : entries) {
+            std::uint32_t format = item.second.format;
+            std::uint32_t length = (std::uint32_t)item.second.binary.size();
+            file.write(reinterpret_cast<const char*>(&item.first), sizeof(item.first));
+            file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(reinterpret_cast<const char*>(item.second.binary.data()), length);
+        }
+        if (!file) {
+            std::cerr << "Failed to write " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to replace " << path << std::endl;
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+bool ProgramCache::isEnabled() const {
+    return enabled;
+}
+
+std::uint64_t ProgramCache::key(const char* vertexSource, const char* fragmentSource) const {
+    std::uint64_t hash = fnv1a(FNV_OFFSET, &driverHash, sizeof(driverHash));
+    hash = fnv1a(hash, vertexSource);
+    return fnv1a(hash, fragmentSource);
+}
+
+bool ProgramCache::find(std::uint64_t entryKey, GLenum& format, const std::vector<unsigned char>*& binary) const {
+    auto found = entries.find(entryKey);
+    if (found == entries.end()) {
+        ++misses;
+        return false;
+    }
+    ++hits;
+    format = found->second.format;
+    binary = &found->second.binary;
+    return true;
+}
+
+void ProgramCache::store(std::uint64_t entryKey, GLenum format, std::vector<unsigned char> binary) {
+    Entry& entry = entries[entryKey];
+    entry.format = format;
+    entry.binary.swap(binary);
+    dirty = true;
+}
+
+// Called for a binary the driver rejected, so its hit becomes a miss
+void ProgramCache::remove(std::uint64_t entryKey) {
+    if (entries.erase(entryKey) == 0) return;
+    dirty = true;
+    if (hits > 0) {
+        --hits;
+        ++misses;
+    }
+}
+
+unsigned int ProgramCache::getHits() const {
+    return hits;
+}
+
+unsigned int ProgramCache::getMisses() const {
+    return misses;
+}
@@ -0,0 +1,46 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <GL/glew.h>
+
+// Linked program binaries kept on disk between runs, so a warm start skips
+// compiling and linking. An entry is keyed by a hash (FNV-1a) of the shader
+// sources and the driver's vendor, renderer and version strings; a driver
+// update changes every key and the old entries are dropped on load. A binary
+// the driver still refuses is removed and its program compiled from source.
+class ProgramCache {
+public:
+    ProgramCache();
+
+    // Needs the GL context. Disabled when the driver cannot hand out binaries.
+    bool load(const std::string& path);
+    bool save();                    // Writes the file if anything changed
+    bool isEnabled() const;
+
+    std::uint64_t key(const char* vertexSource, const char* fragmentSource) const;
+    bool find(std::uint64_t key, GLenum& format, const std::vector<unsigned char>*& binary) const;
+    void store(std::uint64_t key, GLenum format, std::vector<unsigned char> binary);
+    void remove(std::uint64_t key);
+
+    unsigned int getHits() const;
+    unsigned int getMisses() const;
+
+private:
+    struct Entry {
+        GLenum format;
+        std::vector<unsigned char> binary;
+    };
+
+    std::string path;
+    std::uint64_t driverHash;
+    std::unordered_map<std::uint64_t, Entry> entries;
+    bool enabled;
+    bool dirty;
+    mutable unsigned int hits, misses;
+};
+
+#endif // PROGRAMCACHE_H
@@ -0,0 +1,225 @@
+#include "Random.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define RANDOM_SSE2
+#include <emmintrin.h>
+#endif
+
+// Philox4x32 constants (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+static const std::uint32_t MULTIPLIER_0 = 0xD2511F53u;
+static const std::uint32_t MULTIPLIER_1 = 0xCD9E8D57u;
+static const std::uint32_t WEYL_0 = 0x9E3779B9u;
+static const std::uint32_t WEYL_1 = 0xBB67AE85u;
+static const int ROUNDS = 10;
+
+static const float TWO_PI = 6.28318530717958647692f;
+
+// Bulk float fills convert through a stack buffer of this many words
+static const std::size_t CHUNK_WORDS = 256;
+
+Random::Random(std::uint64_t seed, std::uint64_t stream) {
+    this->seed(seed, stream);
+}
+
+std::uint64_t Random::splitMix64(std::uint64_t& state) {
+    std::uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+void Random::seed(std::uint64_t seed, std::uint64_t streamId) {
+    // Scramble the seed so nearby seeds give unrelated keys
+    std::uint64_t state = seed;
+    std::uint64_t mixed = splitMix64(state);
+    key[0] = (std::uint32_t)mixed;
+    key[1] = (std::uint32_t)(mixed >> 32);
+    stream[0] = (std::uint32_t)streamId;
+    stream[1] = (std::uint32_t)(streamId >> 32);
+    counter = 0;
+    bufferIndex = 4;
+}
+
+void Random::generateBlock(std::uint64_t block, std::uint32_t out[4]) const {
+    std::uint32_t c0 = (std::uint32_t)block, c1 = (std::uint32_t)(block >> 32);
+    std::uint32_t c2 = stream[0], c3 = stream[1];
+    std::uint32_t k0 = key[0], k1 = key[1];
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::uint64_t product0 = (std::uint64_t)MULTIPLIER_0 * c0;
+        std::uint64_t product1 = (std::uint64_t)MULTIPLIER_1 * c2;
+        std::uint32_t next0 = (std::uint32_t)(product1 >> 32) ^ c1 ^ k0;
+        std::uint32_t next2 = (std::uint32_t)(product0 >> 32) ^ c3 ^ k1;
+        c1 = (std::uint32_t)product1;
+        c3 = (std::uint32_t)product0;
+        c0 = next0;
+        c2 = next2;
+        k0 += WEYL_0;
+        k1 += WEYL_1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+#ifdef RANDOM_SSE2
+// High and low halves of four 32x32-bit products
+static inline void multiplyHighLow(__m128i a, __m128i b, __m128i& high, __m128i& low) {
+    __m128i even = _mm_mul_epu32(a, b);                                        // Lanes 0 and 2
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)); // Lanes 1 and 3
+    __m128i lowEven = _mm_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 2, 0));        // lo0 lo2 hi0 hi2
+    __m128i lowOdd = _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 2, 0));          // lo1 lo3 hi1 hi3
+    low = _mm_unpacklo_epi32(lowEven, lowOdd);
+    high = _mm_unpackhi_epi32(lowEven, lowOdd);
+}
+#endif
+
+// blockCount consecutive blocks into out, four words per block
+void Random::generateBlocks(std::uint64_t firstBlock, std::size_t blockCount, std::uint32_t* out) const {
+    std::size_t done = 0;
+#ifdef RANDOM_SSE2
+    // Four blocks side by side: lane i of each register belongs to block i
+    const __m128i multiplier0 = _mm_set1_epi32((int)MULTIPLIER_0);
+    const __m128i multiplier1 = _mm_set1_epi32((int)MULTIPLIER_1);
+    for (; done + 4 <= blockCount; done += 4) {
+        std::uint64_t block = firstBlock + done;
+        __m128i c0 = _mm_setr_epi32((int)(std::uint32_t)block, (int)(std::uint32_t)(block + 1),
+            (int)(std::uint32_t)(block + 2), (int)(std::uint32_t)(block + 3));
+        __m128i c1 = _mm_setr_epi32((int)(std::uint32_t)(block >> 32), (int)(std::uint32_t)((block + 1) >> 32),
+            (int)(std::uint32_t)((block + 2) >> 32), (int)(std::uint32_t)((block + 3) >> 32));
+        __m128i c2 = _mm_set1_epi32((int)stream[0]);
+        __m128i c3 = _mm_set1_epi32((int)stream[1]);
+        std::uint32_t k0 = key[0], k1 = key[1];
+
+        for (int round = 0; round < ROUNDS; ++round) {
+            __m128i high0, low0, high1, low1;
+            multiplyHighLow(c0, multiplier0, high0, low0);
+            multiplyHighLow(c2, multiplier1, high1, low1);
+            c0 = _mm_xor_si128(_mm_xor_si128(high1, c1), _mm_set1_epi32((int)k0));
+            c2 = _mm_xor_si128(_mm_xor_si128(high0, c3), _mm_set1_epi32((int)k1));
+            c1 = low1;
+            c3 = low0;
+            k0 += WEYL_0;
+            k1 += WEYL_1;
+        }
+
+        // Transpose back to block order
+        __m128i t0 = _mm_unpacklo_epi32(c0, c1);   // b0w0 b0w1 b1w0 b1w1
+        __m128i t1 = _mm_unpacklo_epi32(c2, c3);   // b0w2 b0w3 b1w2 b1w3
+        __m128i t2 = _mm_unpackhi_epi32(c0, c1);   // b2w0 b2w1 b3w0 b3w1
+        __m128i t3 = _mm_unpackhi_epi32(c2, c3);   // b2w2 b2w3 b3w2 b3w3
+        __m128i* target = reinterpret_cast<__m128i*>(out + done * 4);
+        _mm_storeu_si128(target + 0, _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128(target + 1, _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128(target + 2, _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128(target + 3, _mm_unpackhi_epi64(t2, t3));
+    }
+#endif
+    for (; done < blockCount; ++done) {
+        generateBlock(firstBlock + done, out + done * 4);
+    }
+}
+
+std::uint32_t Random::nextUint32() {
+    if (bufferIndex == 4) {
+        generateBlock(counter++, buffer);
+        bufferIndex = 0;
+    }
+    return buffer[bufferIndex++];
+}
+
+std::uint64_t Random::nextUint64() {
+    std::uint64_t low = nextUint32();
+    return low | ((std::uint64_t)nextUint32() << 32);
+}
+
+float Random::nextFloat() {
+    return (nextUint32() >> 8) * (1.0f / 16777216.0f);
+}
+
+double Random::nextDouble() {
+    return (nextUint64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+float Random::uniform(float low, float high) {
+    return low + (high - low) * nextFloat();
+}
+
+void Random::nextGaussianPair(float& first, float& second) {
+    // Box-Muller; the half-step offset keeps the logarithm away from zero
+    float u1 = ((nextUint32() >> 8) + 0.5f) * (1.0f / 16777216.0f);
+    float u2 = (nextUint32() >> 8) * (1.0f / 16777216.0f);
+    float radius = std::sqrt(-2.0f * std::log(u1));
+    first = radius * std::cos(TWO_PI * u2);
+    second = radius * std::sin(TWO_PI * u2);
+}
+
+void Random::fill(std::uint32_t* out, std::size_t count) {
+    // Use up the current block first so the sequence matches nextUint32
+    while (count > 0 && bufferIndex < 4) {
+        *out++ = buffer[bufferIndex++];
+        --count;
+    }
+
+    std::size_t blocks = count / 4;
+    generateBlocks(counter, blocks, out);
+    counter += blocks;
+    out += blocks * 4;
+    count -= blocks * 4;
+
+    while (count > 0) {
+        *out++ = nextUint32();
+        --count;
+    }
+}
+
+void Random::fillFloats(float* out, std::size_t count) {
+    std::uint32_t words[CHUNK_WORDS];
+    while (count > 0) {
+        std::size_t chunk = count < CHUNK_WORDS ? count : CHUNK_WORDS;
+        fill(words, chunk);
+        for (std::size_t i = 0; i < chunk; ++i) {
+            out[i] = (words[i] >> 8) * (1.0f / 16777216.0f);
+        }
+        out += chunk;
+        count -= chunk;
+    }
+}
+
+void Random::fillGaussians(float* out, std::size_t count, float sigma) {
+    std::uint32_t words[CHUNK_WORDS];
+    while (count > 1) {
+        std::size_t chunk = (count < CHUNK_WORDS ? count : CHUNK_WORDS) & ~(std::size_t)1;
+        fill(words, chunk);
+        for (std::size_t i = 0; i < chunk; i += 2) {
+            float u1 = ((words[i] >> 8) + 0.5f) * (1.0f / 16777216.0f);
+            float u2 = (words[i + 1] >> 8) * (1.0f / 16777216.0f);
+            float radius = std::sqrt(-2.0f * std::log(u1));
+            out[i] = sigma * (radius * std::cos(TWO_PI * u2));
+            out[i + 1] = sigma * (radius * std::sin(TWO_PI * u2));
+        }
+        out += chunk;
+        count -= chunk;
+    }
+    if (count == 1) {
+        float first, second;
+        nextGaussianPair(first, second);
+        *out = sigma * first;
+    }
+}
+
+std::uint64_t Random::getPosition() const {
+    return counter * 4 - (std::uint64_t)(4 - bufferIndex);
+}
+
+void Random::setPosition(std::uint64_t position) {
+    counter = position / 4;
+    bufferIndex = 4;
+    if (position % 4) {
+        generateBlock(counter++, buffer);
+        bufferIndex = (int)(position % 4);
+    }
+}
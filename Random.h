@@ -0,0 +1,49 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Counter-based random numbers (Philox4x32-10). The output is a pure
+// function of (seed, stream, position), so streams are cheap to create,
+// never overlap, and can jump to any position - which is what replays and
+// multi-threaded simulations need. Give every thread or every independent
+// job its own stream id rather than sharing one generator.
+class Random {
+public:
+    explicit Random(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0);
+
+    std::uint32_t nextUint32();
+    std::uint64_t nextUint64();
+    float nextFloat();                          // [0, 1), 24 random bits
+    double nextDouble();                        // [0, 1), 53 random bits
+    float uniform(float low, float high);       // [low, high)
+    void nextGaussianPair(float& first, float& second);  // Two independent N(0, 1)
+
+    // Same values as calling nextUint32 / nextFloat / nextGaussianPair (times
+    // sigma) repeatedly, but four Philox blocks at a time with SSE2
+    void fill(std::uint32_t* out, std::size_t count);
+    void fillFloats(float* out, std::size_t count);
+    void fillGaussians(float* out, std::size_t count, float sigma = 1.0f);
+
+    // Number of 32-bit words drawn so far; setPosition rewinds or skips in O(1)
+    std::uint64_t getPosition() const;
+    void setPosition(std::uint64_t position);
+
+    // SplitMix64 step, handy for turning one seed into many
+    static std::uint64_t splitMix64(std::uint64_t& state);
+
+private:
+    std::uint32_t key[2];
+    std::uint32_t stream[2];    // High half of the Philox counter
+    std::uint64_t counter;      // Next block to generate
+    std::uint32_t buffer[4];    // Block counter - 1
+    int bufferIndex;            // Next unused word in buffer, 4 when empty
+
+    void generateBlock(std::uint64_t block, std::uint32_t out[4]) const;
+    void generateBlocks(std::uint64_t firstBlock, std::size_t blockCount, std::uint32_t* out) const;
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,154 @@
+#include "ReplayEngine.h"
+#include <algorithm>
+
+// Long waits between throws (pauses, a break between legs) are cut to this
+static const double MAX_GAP_TICKS = 3.0 * Game::TICKS_PER_SECOND;
+
+ReplayEngine::ReplayEngine(const X01Rules& rules)
+    : game(0, rules), records(nullptr), count(0), position(0), playbackTick(0.0), speed(MIN_SPEED), playing(true) {
+}
+
+std::vector<ReplayMatch> ReplayEngine::findMatches(const ThrowLogReader& log) {
+    std::vector<ReplayMatch> matches;
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < log.size(); ++i) {
+        bool last = i + 1 == log.size() || log[i].result == X01Rules::FINISHED || log[i + 1].tick < log[i].tick;
+        if (last) {
+            matches.push_back({ first, i + 1 - first });
+            first = i + 1;
+        }
+    }
+    return matches;
+}
+
+ThrowState ReplayEngine::toThrowState(const ThrowRecord& record) {
+    ThrowState state;
+    state.tick = record.tick;
+    state.player = record.player;
+    state.crosshairX = record.crosshairX;
+    state.crosshairY = record.crosshairY;
+    state.boardX = record.boardX;
+    state.boardY = record.boardY;
+    state.score = record.score;
+    state.dartsLeft = record.dartsLeft;
+    state.result = record.result;
+    return state;
+}
+
+std::size_t ReplayEngine::load(const ThrowRecord* matchRecords, std::size_t matchCount) {
+    records = matchRecords;
+    count = matchCount;
+    keyframes.clear();
+    turnStarts.clear();
+    game.init();
+
+    // One pass over the match to lay down keyframes and turn boundaries
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const GameState& before = game.getState();
+        if (i % KEYFRAME_INTERVAL == 0) keyframes.push_back({ i, before });
+        if (i == 0 || before.phase == GameState::CLEARING || records[i].player != before.activePlayer) {
+            turnStarts.push_back(i);
+        }
+
+        std::uint64_t throwsBefore = before.throwCount;
+        game.replayThrow(toThrowState(records[i]));
+        const GameState& after = game.getState();
+        if (after.throwCount == throwsBefore || after.lastThrow.score != records[i].score || after.lastThrow.result != records[i].result) {
+            ++mismatches;
+        }
+    }
+    if (keyframes.empty()) keyframes.push_back({ 0, game.getState() });
+
+    seekThrow(0);
+    return mismatches;
+}
+
+void ReplayEngine::applyNext() {
+    game.replayThrow(toThrowState(records[position]));
+    ++position;
+}
+
+void ReplayEngine::update(float dt) {
+    if (!playing || position >= count) return;
+
+    playbackTick += (double)dt * Game::TICKS_PER_SECOND * speed;
+    double nextTick = records[position].tick;
+    if (nextTick - playbackTick > MAX_GAP_TICKS) playbackTick = nextTick - MAX_GAP_TICKS;
+
+    while (position < count && records[position].tick <= playbackTick) {
+        applyNext();
+    }
+}
+
+void ReplayEngine::seekThrow(std::size_t throwIndex) {
+    if (throwIndex > count) throwIndex = count;
+
+    // Last keyframe at or before the target
+    auto after = std::upper_bound(keyframes.begin(), keyframes.end(), throwIndex,
+        [](std::size_t index, const Keyframe& keyframe) { return index < keyframe.throwIndex; });
+    const Keyframe& keyframe = *(after - 1);
+
+    game.setState(keyframe.state);
+    position = keyframe.throwIndex;
+    while (position < throwIndex) {
+        applyNext();
+    }
+
+    if (position > 0) playbackTick = records[position - 1].tick;
+    else playbackTick = count ? (double)records[0].tick - MAX_GAP_TICKS : 0.0;
+}
+
+void ReplayEngine::seekTurn(std::size_t turn) {
+    if (turnStarts.empty()) {
+        seekThrow(0);
+        return;
+    }
+    if (turn >= turnStarts.size()) turn = turnStarts.size() - 1;
+
+    seekThrow(turnStarts[turn]);
+    // Show the new turn's empty board rather than the last turn's darts
+    if (game.getState().phase == GameState::CLEARING) game.switchTurn();
+}
+
+void ReplayEngine::setSpeed(float newSpeed) {
+    speed = newSpeed;
+    if (speed < MIN_SPEED) speed = MIN_SPEED;
+    if (speed > MAX_SPEED) speed = MAX_SPEED;
+}
+
+float ReplayEngine::getSpeed() const {
+    return speed;
+}
+
+void ReplayEngine::setPlaying(bool newPlaying) {
+    playing = newPlaying;
+}
+
+bool ReplayEngine::isPlaying() const {
+    return playing;
+}
+
+std::size_t ReplayEngine::getThrowCount() const {
+    return count;
+}
+
+std::size_t ReplayEngine::getTurnCount() const {
+    return turnStarts.size();
+}
+
+std::size_t ReplayEngine::getPosition() const {
+    return position;
+}
+
+std::size_t ReplayEngine::getTurn() const {
+    // While the last turn's darts are still shown, that is the turn on screen
+    std::size_t shown = position;
+    if (shown > 0 && (shown == count || game.getState().phase != GameState::AIMING || game.getState().dartCount > 0)) --shown;
+    auto after = std::upper_bound(turnStarts.begin(), turnStarts.end(), shown);
+    return after == turnStarts.begin() ? 0 : (std::size_t)(after - turnStarts.begin()) - 1;
+}
+
+const Game& ReplayEngine::getGame() const {
+    return game;
+}
@@ -0,0 +1,73 @@
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include <cstddef>
+#include <vector>
+#include "Game.h"
+#include "ThrowLog.h"
+#include "X01Rules.h"
+
+// A match in a throw log: records [first, first + count)
+struct ReplayMatch {
+    std::size_t first;
+    std::size_t count;
+};
+
+// Plays a recorded match back through Game, in game time at 1x to 1000x,
+// and jumps to any throw or turn. Loading replays the match once and keeps
+// a GameState keyframe every KEYFRAME_INTERVAL throws; a seek restores the
+// nearest keyframe before the target (binary search) and replays at most
+// KEYFRAME_INTERVAL - 1 throws from there.
+class ReplayEngine {
+public:
+    static const std::size_t KEYFRAME_INTERVAL = 32;
+    static constexpr float MIN_SPEED = 1.0f;
+    static constexpr float MAX_SPEED = 1000.0f;
+
+    explicit ReplayEngine(const X01Rules& rules = X01Rules::house());
+
+    // A new match starts after a finishing dart or where the tick goes back
+    static std::vector<ReplayMatch> findMatches(const ThrowLogReader& log);
+
+    // The records must outlive the engine (they usually live in a mapped log).
+    // Returns the number of throws whose recorded score or result differ from
+    // the replay, which means the match was played with other rules.
+    std::size_t load(const ThrowRecord* records, std::size_t count);
+
+    void update(float dt);                  // Advance playback by dt seconds of real time
+    void seekThrow(std::size_t throwIndex); // State after throwIndex throws
+    void seekTurn(std::size_t turn);        // Start of a turn, board cleared
+
+    void setSpeed(float speed);             // Clamped to [MIN_SPEED, MAX_SPEED]
+    float getSpeed() const;
+    void setPlaying(bool playing);
+    bool isPlaying() const;
+
+    std::size_t getThrowCount() const;
+    std::size_t getTurnCount() const;
+    std::size_t getPosition() const;        // Throws applied so far
+    std::size_t getTurn() const;            // Turn the last applied throw belongs to
+    const Game& getGame() const;
+
+private:
+    struct Keyframe {
+        std::size_t throwIndex;             // Throws applied before this state
+        GameState state;
+    };
+
+    Game game;
+    const ThrowRecord* records;
+    std::size_t count;
+    std::vector<Keyframe> keyframes;        // Sorted by throwIndex, first one at 0
+    std::vector<std::size_t> turnStarts;    // Index of the first throw of each turn
+
+    std::size_t position;
+    double playbackTick;                    // Game time being shown
+    float speed;
+    bool playing;
+
+    void applyNext();
+    static ThrowState toThrowState(const ThrowRecord& record);
+};
+
+#endif // REPLAYENGINE_H
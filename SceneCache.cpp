@@ -0,0 +1,132 @@
+#include "SceneCache.h"
+#include <cstring>
+#include <iostream>
+
+SceneCache::SceneCache() : projection(1.0f), view(1.0f) {}
+
+SceneCache::~SceneCache() {
+    if (FBO != 0) glDeleteFramebuffers(1, &FBO);
+    if (texture != 0) glDeleteTextures(1, &texture);
+    if (VBO != 0) glDeleteBuffers(1, &VBO);
+    if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+}
+
+void SceneCache::initialize() {
+    // Full-screen quad in NDC with its texture coordinates
+    GLfloat vertices[] = {
+        -1.0f, -1.0f,   0.0f, 0.0f,
+         1.0f, -1.0f,   1.0f, 0.0f,
+        -1.0f,  1.0f,   0.0f, 1.0f,
+         1.0f,  1.0f,   1.0f, 1.0f
+    };
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid*)(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    const char* vertexShaderSource = R"(
+        #version 330 core
+        layout(location = 0) in vec2 aPos;
+        layout(location = 1) in vec2 aTexCoord;
+        out vec2 TexCoord;
+        void main() {
+            gl_Position = vec4(aPos, 0.0, 1.0);
+            TexCoord = aTexCoord;
+        }
+    )";
+
+    const char* fragmentShaderSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 TexCoord;
+        uniform sampler2D scene;
+        void main() {
+            FragColor = texture(scene, TexCoord);
+        }
+    )";
+
+    shader.loadSource(vertexShaderSource, fragmentShaderSource);
+    shader.use();
+    glUniform1i(shader.getUniformLocation("scene"), 0);
+    glUseProgram(0);
+
+    glGenTextures(1, &texture);
+    glGenFramebuffers(1, &FBO);
+}
+
+bool SceneCache::begin(const glm::mat4& newProjection, const glm::mat4& newView, unsigned long long newSceneVersion) {
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    int newWidth = previousViewport[2], newHeight = previousViewport[3];
+
+    if (valid && newWidth == width && newHeight == height && newSceneVersion == sceneVersion
+        && std::memcmp(&newProjection, &projection, sizeof(projection)) == 0
+        && std::memcmp(&newView, &view, sizeof(view)) == 0) {
+        return false;
+    }
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    if (newWidth != width || newHeight != height) {
+        // Same size as the viewport and sampled with NEAREST, so the copy is
+        // pixel for pixel what drawing straight to the screen gives
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Error: Scene cache framebuffer is incomplete!" << std::endl;
+        }
+        width = newWidth;
+        height = newHeight;
+    }
+
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    projection = newProjection;
+    view = newView;
+    sceneVersion = newSceneVersion;
+    valid = true;
+    ++redraws;
+    return true;
+}
+
+void SceneCache::end() {
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+}
+
+void SceneCache::draw() {
+    GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+    glDisable(GL_BLEND);
+
+    shader.use();
+    glBindVertexArray(VAO);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    if (blendEnabled) glEnable(GL_BLEND);
+}
+
+void SceneCache::invalidate() {
+    valid = false;
+}
+
+unsigned long long SceneCache::getRedrawCount() const {
+    return redraws;
+}
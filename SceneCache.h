@@ -0,0 +1,50 @@
+#ifndef SCENECACHE_H
+#define SCENECACHE_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "ShaderProgram.h"
+
+// The static part of the scene (background and board) rendered into a
+// texture the size of the viewport, and redrawn only when the camera, the
+// viewport or the board's overlays change. Other frames copy the texture to
+// the screen with one textured quad instead of lighting every board pixel.
+//
+//   if (cache.begin(projection, view, dartboard.getBoardVersion())) {
+//       background.render();
+//       dartboard.renderBoard();
+//       cache.end();
+//   }
+//   cache.draw();
+class SceneCache {
+public:
+    SceneCache();
+    ~SceneCache();
+    void initialize();
+
+    // True when the layer is out of date: it is then the render target
+    // (cleared, viewport-sized) until end()
+    bool begin(const glm::mat4& projection, const glm::mat4& view, unsigned long long sceneVersion);
+    void end();
+
+    // Copies the layer over the whole viewport (opaque, blending off)
+    void draw();
+    void invalidate();
+    unsigned long long getRedrawCount() const;
+
+private:
+    SceneCache(const SceneCache&) = delete;
+    SceneCache& operator=(const SceneCache&) = delete;
+
+    GLuint FBO = 0, texture = 0, VAO = 0, VBO = 0;
+    ShaderProgram shader;
+    int width = 0, height = 0;
+    glm::mat4 projection, view;
+    unsigned long long sceneVersion = 0;
+    bool valid = false;
+    unsigned long long redraws = 0;
+    GLint previousFramebuffer = 0;
+    GLint previousViewport[4] = {};
+};
+
+#endif // SCENECACHE_H
@@ -0,0 +1,48 @@
+#include "SceneUniforms.h"
+#include "ShaderProgram.h"
+#include <cstring>
+
+SceneUniforms::SceneUniforms() {
+    glGenBuffers(1, &cameraBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+    glGenBuffers(1, &lightingBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, lightingBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightingBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, cameraBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, LIGHTING_BLOCK_BINDING, lightingBuffer);
+}
+
+SceneUniforms::~SceneUniforms() {
+    glDeleteBuffers(1, &cameraBuffer);
+    glDeleteBuffers(1, &lightingBuffer);
+}
+
+void SceneUniforms::setCamera(const glm::mat4& projection, const glm::mat4& view) {
+    CameraBlock block;
+    block.projection = projection;
+    block.view = view;
+    if (cameraSet && std::memcmp(&block, &camera, sizeof(block)) == 0) return;
+    camera = block;
+    cameraSet = true;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &camera);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void SceneUniforms::setLighting(const glm::vec3& lightPos, const glm::vec3& viewPos, const glm::vec3& lightColor) {
+    LightingBlock block;
+    block.lightPos = glm::vec4(lightPos, 0.0f);
+    block.viewPos = glm::vec4(viewPos, 0.0f);
+    block.lightColor = glm::vec4(lightColor, 0.0f);
+    if (lightingSet && std::memcmp(&block, &lighting, sizeof(block)) == 0) return;
+    lighting = block;
+    lightingSet = true;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, lightingBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightingBlock), &lighting);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
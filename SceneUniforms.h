@@ -0,0 +1,39 @@
+#ifndef SCENEUNIFORMS_H
+#define SCENEUNIFORMS_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// The camera and lighting uniform buffers every 3D program reads, bound to
+// CAMERA_BLOCK_BINDING and LIGHTING_BLOCK_BINDING. Set them once per frame
+// (or once, for lighting); a value equal to the last upload is not sent again.
+class SceneUniforms {
+public:
+    SceneUniforms();
+    ~SceneUniforms();
+
+    void setCamera(const glm::mat4& projection, const glm::mat4& view);
+    void setLighting(const glm::vec3& lightPos, const glm::vec3& viewPos, const glm::vec3& lightColor);
+
+private:
+    SceneUniforms(const SceneUniforms&) = delete;
+    SceneUniforms& operator=(const SceneUniforms&) = delete;
+
+    // std140 layouts of the two blocks
+    struct CameraBlock {
+        glm::mat4 projection;
+        glm::mat4 view;
+    };
+    struct LightingBlock {
+        glm::vec4 lightPos;     // vec3 padded to 16 bytes
+        glm::vec4 viewPos;
+        glm::vec4 lightColor;
+    };
+
+    GLuint cameraBuffer = 0, lightingBuffer = 0;
+    CameraBlock camera;
+    LightingBlock lighting;
+    bool cameraSet = false, lightingSet = false;
+};
+
+#endif // SCENEUNIFORMS_H
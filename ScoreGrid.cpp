@@ -0,0 +1,160 @@
+#include "ScoreGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Cells are grown by this much before testing them against the wires, so a
+// cell counts as uniform only if float rounding in BoardScorer cannot flip
+// any point inside it to a neighbouring segment
+static const double WIRE_MARGIN = 1e-6;
+
+// Sector index of a point in exact (double) geometry, or -1 if a cell corner
+// grown by WIRE_MARGIN could end up on the other side of a boundary
+static signed char exactSector(double x, double y) {
+    double degrees = std::atan2(y, x) * 180.0 / BoardSpec::PI - BoardSpec::FIRST_BOUNDARY_DEGREES;
+    while (degrees < 0.0) degrees += 360.0;
+    double position = degrees / BoardSpec::SECTOR_DEGREES;
+    double nearestBoundary = std::fabs(position - std::floor(position + 0.5)) * BoardSpec::SECTOR_DEGREES * BoardSpec::PI / 180.0;
+    double radius = std::sqrt(x * x + y * y);
+    if (radius * std::sin(std::min(nearestBoundary, BoardSpec::PI / 2)) <= 2.0 * WIRE_MARGIN) return -1;
+    return (signed char)((int)position % 20);
+}
+
+ScoreGrid::ScoreGrid(const BoardScorer& scorer, int resolution)
+    : scorer(scorer), resolution(resolution), wireCells(0) {
+    // Leave a thin border of misses around the outer ring
+    extent = std::sqrt(scorer.getRingsSquared().outer) * 1.01f;
+    cellsPerUnit = resolution / (2.0f * extent);
+
+    // Sector of every grid corner, shared by the four cells that meet there
+    double cellSize = 2.0 * extent / resolution;
+    std::vector<signed char> cornerSectors((std::size_t)(resolution + 1) * (resolution + 1));
+    for (int row = 0; row <= resolution; ++row) {
+        for (int column = 0; column <= resolution; ++column) {
+            cornerSectors[(std::size_t)row * (resolution + 1) + column] =
+                exactSector(-extent + column * cellSize, -extent + row * cellSize);
+        }
+    }
+
+    cells.resize((std::size_t)resolution * resolution);
+    for (int row = 0; row < resolution; ++row) {
+        for (int column = 0; column < resolution; ++column) {
+            const signed char* corners = &cornerSectors[(std::size_t)row * (resolution + 1) + column];
+            bakeCell(column, row, corners, corners + resolution + 1);
+        }
+    }
+}
+
+unsigned char ScoreGrid::encode(const BoardSegment& segment) {
+    if (segment.number == 0) return 0;                          // Miss
+    if (segment.number == 25) return 60 + segment.multiplier;   // 61 outer bull, 62 bullseye
+    return (segment.number - 1) * 3 + segment.multiplier;       // 1-60
+}
+
+BoardSegment ScoreGrid::decode(unsigned char code) {
+    if (code == 0) return { 0, 0 };
+    if (code > 60) return { 25, code - 60 };
+    return { (code - 1) / 3 + 1, (code - 1) % 3 + 1 };
+}
+
+void ScoreGrid::bakeCell(int column, int row, const signed char* lowerCorners, const signed char* upperCorners) {
+    double cellSize = 2.0 * extent / resolution;
+    double x0 = -extent + column * cellSize - WIRE_MARGIN;
+    double y0 = -extent + row * cellSize - WIRE_MARGIN;
+    double x1 = x0 + cellSize + 2.0 * WIRE_MARGIN;
+    double y1 = y0 + cellSize + 2.0 * WIRE_MARGIN;
+    unsigned char& cell = cells[(std::size_t)row * resolution + column];
+
+    // Distance range from the centre of the board to the cell
+    double nearX = std::min(std::max(0.0, x0), x1);
+    double nearY = std::min(std::max(0.0, y0), y1);
+    double minRadius = std::sqrt(nearX * nearX + nearY * nearY);
+    double farX = std::max(std::fabs(x0), std::fabs(x1));
+    double farY = std::max(std::fabs(y0), std::fabs(y1));
+    double maxRadius = std::sqrt(farX * farX + farY * farY);
+
+    const BoardRings& rings = scorer.getRingsSquared();
+    const float thresholds[] = { rings.bullseyeInner, rings.bullseyeOuter, rings.tripleInner,
+        rings.tripleOuter, rings.doubleInner, rings.doubleOuter, rings.outer };
+    for (float threshold : thresholds) {
+        double radius = std::sqrt((double)threshold);
+        if (minRadius <= radius && radius <= maxRadius) {
+            cell = WIRE;
+            wireCells++;
+            return;
+        }
+    }
+
+    // A single ring; the bull and the area outside the board have no sectors
+    BoardSegment centre = scorer.segment((float)((x0 + x1) * 0.5), (float)((y0 + y1) * 0.5));
+    if (centre.number != 0 && centre.number != 25) {
+        // Sectors are convex, so the cell is inside one if all of its corners are
+        int sector = lowerCorners[0];
+        if (sector < 0 || lowerCorners[1] != sector || upperCorners[0] != sector || upperCorners[1] != sector) {
+            cell = WIRE;
+            wireCells++;
+            return;
+        }
+    }
+
+    cell = encode(centre);
+}
+
+BoardSegment ScoreGrid::segment(float x, float y, ScoreGridStats* stats) const {
+    float gridX = (x + extent) * cellsPerUnit;
+    float gridY = (y + extent) * cellsPerUnit;
+
+    // Outside the grid is outside the board; the exact path rejects it right away
+    if (!(gridX >= 0.0f && gridX < resolution && gridY >= 0.0f && gridY < resolution)) {
+        return scorer.segment(x, y);
+    }
+
+    unsigned char code = cells[(std::size_t)gridY * resolution + (std::size_t)gridX];
+    if (stats) stats->lookups++;
+    if (code == WIRE) {
+        if (stats) stats->fallbacks++;
+        return scorer.segment(x, y);
+    }
+    return decode(code);
+}
+
+int ScoreGrid::score(float x, float y, ScoreGridStats* stats) const {
+    return segment(x, y, stats).score();
+}
+
+void ScoreGrid::scoreBatch(const float* xs, const float* ys, int* scores, std::size_t count, ScoreGridStats* stats) const {
+    ScoreGridStats local;
+    for (std::size_t i = 0; i < count; ++i) {
+        scores[i] = segment(xs[i], ys[i], &local).score();
+    }
+    if (stats) {
+        stats->lookups += local.lookups;
+        stats->fallbacks += local.fallbacks;
+    }
+}
+
+int ScoreGrid::getResolution() const {
+    return resolution;
+}
+
+float ScoreGrid::getExtent() const {
+    return extent;
+}
+
+std::size_t ScoreGrid::getMemoryBytes() const {
+    return cells.size() * sizeof(unsigned char) + sizeof(*this);
+}
+
+std::size_t ScoreGrid::getWireCellCount() const {
+    return wireCells;
+}
+
+void ScoreGrid::printReport(const ScoreGridStats* stats) const {
+    std::cout << "Score grid: " << resolution << "x" << resolution << " cells, "
+        << getMemoryBytes() / 1024.0 << " KiB, "
+        << 100.0 * wireCells / cells.size() << "% wire cells" << std::endl;
+    if (stats) {
+        std::cout << "Score grid lookups: " << stats->lookups << ", exact fallbacks: " << stats->fallbacks
+            << " (" << 100.0 * stats->fallbackRate() << "%)" << std::endl;
+    }
+}
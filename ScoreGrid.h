@@ -0,0 +1,54 @@
+#ifndef SCOREGRID_H
+#define SCOREGRID_H
+
+#include <cstddef>
+#include <vector>
+#include "BoardScorer.h"
+
+// Lookup and fallback counters; kept outside the grid so one grid can be
+// shared between threads that each count on their own
+struct ScoreGridStats {
+    unsigned long long lookups = 0;
+    unsigned long long fallbacks = 0;  // Lookups that landed in a wire cell
+
+    double fallbackRate() const { return lookups ? (double)fallbacks / lookups : 0.0; }
+};
+
+// The board rasterized once into a square grid of segment codes. Cells that
+// lie entirely inside one segment answer with a single memory read; cells a
+// wire passes through fall back to the exact BoardScorer geometry.
+class ScoreGrid {
+public:
+    ScoreGrid(const BoardScorer& scorer, int resolution = 1024);
+
+    BoardSegment segment(float x, float y, ScoreGridStats* stats = nullptr) const;
+    int score(float x, float y, ScoreGridStats* stats = nullptr) const;
+    void scoreBatch(const float* xs, const float* ys, int* scores, std::size_t count, ScoreGridStats* stats = nullptr) const;
+
+    int getResolution() const;
+    float getExtent() const;               // The grid covers [-extent, extent] on both axes
+    std::size_t getMemoryBytes() const;
+    std::size_t getWireCellCount() const;
+
+    void printReport(const ScoreGridStats* stats = nullptr) const;
+
+    // One byte per segment: 0 miss, 1-60 for (number - 1) * 3 + multiplier,
+    // 61 outer bull, 62 bullseye
+    static const int SEGMENT_CODES = 63;
+    static unsigned char encode(const BoardSegment& segment);
+    static BoardSegment decode(unsigned char code);
+
+private:
+    static const unsigned char WIRE = 255;
+
+    BoardScorer scorer;
+    int resolution;
+    float extent;
+    float cellsPerUnit;
+    std::size_t wireCells;
+    std::vector<unsigned char> cells;
+
+    void bakeCell(int column, int row, const signed char* lowerCorners, const signed char* upperCorners);
+};
+
+#endif // SCOREGRID_H
@@ -0,0 +1,136 @@
+#include "ScriptedInput.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static const std::uint64_t SCRIPT_STREAM = 2;   // Game shake uses stream 1
+
+// Aims anywhere on the scoring area at zoom level 1, throws, and gives the
+// crosshair a few ticks to settle before the next dart
+static const char* DEFAULT_SCRIPT =
+    "random 0.4\n"
+    "throw\n"
+    "wait 4\n";
+
+ScriptedInput::ScriptedInput(std::uint64_t seed) : current(0), tickInCommand(0), seed(seed) {
+    useDefaultScript();
+}
+
+bool ScriptedInput::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open input script: " << path << std::endl;
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return parse(contents.str(), path);
+}
+
+bool ScriptedInput::parse(const std::string& script, const std::string& source) {
+    std::vector<Command> parsed;
+    bool takesTime = false;
+
+    std::istringstream lines(script);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream words(line);
+        std::string name;
+        if (!(words >> name)) continue;
+
+        Command command = { Command::WAIT, 0.0f, 0.0f, 0 };
+        bool ok = true;
+        if (name == "aim") {
+            command.type = Command::AIM;
+            ok = static_cast<bool>(words >> command.x >> command.y);
+        }
+        else if (name == "random") {
+            command.type = Command::RANDOM_AIM;
+            ok = static_cast<bool>(words >> command.x) && command.x >= 0.0f;
+        }
+        else if (name == "throw") {
+            command.type = Command::THROW;
+            command.ticks = 2;
+        }
+        else if (name == "pause") {
+            command.type = Command::PAUSE;
+            command.ticks = 2;
+        }
+        else if (name == "wait") {
+            command.type = Command::WAIT;
+            ok = static_cast<bool>(words >> command.ticks) && command.ticks > 0;
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << source << ":" << lineNumber << ": bad command: " << line << std::endl;
+            return false;
+        }
+        takesTime = takesTime || command.ticks > 0;
+        parsed.push_back(command);
+    }
+
+    if (parsed.empty()) {
+        std::cerr << source << ": script has no commands" << std::endl;
+        return false;
+    }
+    // A script of only aims would never let a tick pass
+    if (!takesTime) parsed.push_back({ Command::WAIT, 0.0f, 0.0f, 1 });
+
+    commands.swap(parsed);
+    restart();
+    return true;
+}
+
+void ScriptedInput::useDefaultScript() {
+    parse(DEFAULT_SCRIPT, "default script");
+}
+
+void ScriptedInput::restart() {
+    restart(seed);
+}
+
+void ScriptedInput::restart(std::uint64_t matchSeed) {
+    current = 0;
+    tickInCommand = 0;
+    input = GameInput();
+    random.seed(matchSeed, SCRIPT_STREAM);
+}
+
+GameInput ScriptedInput::next() {
+    // Aims take no time; run them until a command that lasts a tick
+    while (commands[current].ticks == 0) {
+        const Command& command = commands[current];
+        if (command.type == Command::AIM) {
+            input.aimX = command.x;
+            input.aimY = command.y;
+        }
+        else {
+            // Uniform over the disc
+            float radius = command.x * std::sqrt(random.nextFloat());
+            float angle = random.uniform(0.0f, 6.28318530718f);
+            input.aimX = radius * std::cos(angle);
+            input.aimY = radius * std::sin(angle);
+        }
+        current = (current + 1) % commands.size();
+    }
+
+    const Command& command = commands[current];
+    GameInput tickInput = input;
+    if (command.type == Command::THROW) tickInput.throwHeld = tickInCommand == 0;
+    if (command.type == Command::PAUSE) tickInput.pauseHeld = tickInCommand == 0;
+
+    if (++tickInCommand >= command.ticks) {
+        tickInCommand = 0;
+        current = (current + 1) % commands.size();
+    }
+    return tickInput;
+}
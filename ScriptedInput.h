@@ -0,0 +1,47 @@
+#ifndef SCRIPTEDINPUT_H
+#define SCRIPTEDINPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Game.h"
+#include "Random.h"
+
+// Stands in for the mouse and keyboard when there is no window. A script is
+// one command per line and repeats from the top when it runs out:
+//
+//   aim X Y      move the cursor to (X, Y) in NDC
+//   random R     move the cursor to a random point within R of the centre
+//   throw        press the left button for one tick, release for one tick
+//   wait N       keep the current input for N ticks
+//   pause        press and release Esc
+//   # ...        comment
+class ScriptedInput {
+public:
+    explicit ScriptedInput(std::uint64_t seed = 0);
+
+    bool load(const std::string& path);
+    bool parse(const std::string& script, const std::string& source = "script");
+    void useDefaultScript();            // Random aim over the board, one throw every few ticks
+
+    GameInput next();                   // Input for the coming tick
+    void restart();                     // Back to the first command, same random stream
+    void restart(std::uint64_t matchSeed);  // Back to the first command, new random stream
+
+private:
+    struct Command {
+        enum Type { AIM, RANDOM_AIM, THROW, WAIT, PAUSE } type;
+        float x, y;                     // AIM target or RANDOM_AIM radius (x)
+        int ticks;                      // Ticks the command takes
+    };
+
+    std::vector<Command> commands;
+    std::size_t current;                // Command being run
+    int tickInCommand;
+    GameInput input;
+    Random random;
+    std::uint64_t seed;
+};
+
+#endif // SCRIPTEDINPUT_H
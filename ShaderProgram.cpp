@@ -0,0 +1,207 @@
+#include "ShaderProgram.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "AssetPack.h"
+#include "AssetPreloader.h"
+
+ProgramCache* ShaderProgram::binaryCache = nullptr;
+AssetPreloader* ShaderProgram::sourcePreloader = nullptr;
+
+ShaderProgram::ShaderProgram() {}
+
+ShaderProgram::~ShaderProgram() {
+    if (program != 0) glDeleteProgram(program);
+}
+
+void ShaderProgram::setBinaryCache(ProgramCache* cache) {
+    binaryCache = cache;
+}
+
+void ShaderProgram::setSourcePreloader(AssetPreloader* preloader) {
+    sourcePreloader = preloader;
+}
+
+static bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open shader file: " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+bool ShaderProgram::loadFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
+    // Packed files end in a NUL, so the mapping is used as is
+    AssetView vertexView, fragmentView;
+    if (findAsset(vertexShaderPath, vertexView) && findAsset(fragmentShaderPath, fragmentView)) {
+        return build(reinterpret_cast<const char*>(vertexView.data), reinterpret_cast<const char*>(fragmentView.data), vertexShaderPath, fragmentShaderPath);
+    }
+
+    const std::string* vertexPreloaded = sourcePreloader ? sourcePreloader->getShaderSource(vertexShaderPath) : nullptr;
+    const std::string* fragmentPreloaded = sourcePreloader ? sourcePreloader->getShaderSource(fragmentShaderPath) : nullptr;
+    if (vertexPreloaded && fragmentPreloaded) {
+        return build(vertexPreloaded->c_str(), fragmentPreloaded->c_str(), vertexShaderPath, fragmentShaderPath);
+    }
+
+    std::string vertexSource, fragmentSource;
+    if (!readFile(vertexShaderPath, vertexSource) || !readFile(fragmentShaderPath, fragmentSource)) return false;
+
+    return build(vertexSource.c_str(), fragmentSource.c_str(), vertexShaderPath, fragmentShaderPath);
+}
+
+bool ShaderProgram::loadSource(const char* vertexSource, const char* fragmentSource) {
+    return build(vertexSource, fragmentSource, "vertex shader", "fragment shader");
+}
+
+bool ShaderProgram::build(const char* vertexSource, const char* fragmentSource, const std::string& vertexName, const std::string& fragmentName) {
+    if (program != 0) glDeleteProgram(program);
+    program = 0;
+    uniforms.clear();
+
+    std::string name = vertexName + " + " + fragmentName;
+    bool cached = binaryCache && binaryCache->isEnabled();
+    std::uint64_t key = cached ? binaryCache->key(vertexSource, fragmentSource) : 0;
+    if (cached && loadBinary(key, name)) return true;
+
+    GLuint vertexShader = compile(GL_VERTEX_SHADER, vertexSource, vertexName);
+    GLuint fragmentShader = compile(GL_FRAGMENT_SHADER, fragmentSource, fragmentName);
+    if (!link(vertexShader, fragmentShader, name, cached)) return false;
+    if (cached) storeBinary(key);
+    return true;
+}
+
+bool ShaderProgram::loadBinary(std::uint64_t key, const std::string& name) {
+    GLenum format;
+    const std::vector<unsigned char>* binary;
+    if (!binaryCache->find(key, format, binary)) return false;
+
+    GLuint restored = glCreateProgram();
+    glProgramBinary(restored, format, binary->data(), (GLsizei)binary->size());
+    int success;
+    glGetProgramiv(restored, GL_LINK_STATUS, &success);
+    if (!success) {
+        // The driver may reject its own binaries after an update it does not
+        // report in its version string
+        std::cout << "Cached binary for " << name << " rejected; compiling from source" << std::endl;
+        glDeleteProgram(restored);
+        binaryCache->remove(key);
+        return false;
+    }
+
+    program = restored;
+    resolveUniforms();
+    return true;
+}
+
+void ShaderProgram::storeBinary(std::uint64_t key) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<unsigned char> binary(length);
+    GLenum format;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+    binary.resize(written);
+    binaryCache->store(key, format, std::move(binary));
+}
+
+GLuint ShaderProgram::compile(GLenum type, const char* source, const std::string& name) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        std::cerr << "Error compiling " << name << ": " << infoLog << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool ShaderProgram::link(GLuint vertexShader, GLuint fragmentShader, const std::string& name, bool retrievable) {
+    if (vertexShader == 0 || fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    GLuint linked = glCreateProgram();
+    glAttachShader(linked, vertexShader);
+    glAttachShader(linked, fragmentShader);
+    if (retrievable) glProgramParameteri(linked, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(linked);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    int success;
+    char infoLog[512];
+    glGetProgramiv(linked, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(linked, 512, nullptr, infoLog);
+        std::cerr << "Error linking " << name << ": " << infoLog << std::endl;
+        glDeleteProgram(linked);
+        return false;
+    }
+
+    program = linked;
+    resolveUniforms();
+    return true;
+}
+
+void ShaderProgram::resolveUniforms() {
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<GLchar> name(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+        GLint location = glGetUniformLocation(program, name.data());
+        if (location < 0) continue;     // Lives in a uniform block
+
+        std::string uniformName(name.data(), length);
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0) {
+            uniformName.resize(uniformName.size() - 3);     // Arrays are reported as "name[0]"
+        }
+        uniforms.emplace_back(uniformName, location);
+    }
+    std::sort(uniforms.begin(), uniforms.end());
+
+    GLuint camera = glGetUniformBlockIndex(program, "Camera");
+    if (camera != GL_INVALID_INDEX) glUniformBlockBinding(program, camera, CAMERA_BLOCK_BINDING);
+    GLuint lighting = glGetUniformBlockIndex(program, "Lighting");
+    if (lighting != GL_INVALID_INDEX) glUniformBlockBinding(program, lighting, LIGHTING_BLOCK_BINDING);
+}
+
+void ShaderProgram::use() const {
+    glUseProgram(program);
+}
+
+GLuint ShaderProgram::getId() const {
+    return program;
+}
+
+bool ShaderProgram::isValid() const {
+    return program != 0;
+}
+
+GLint ShaderProgram::getUniformLocation(const char* name) const {
+    auto found = std::lower_bound(uniforms.begin(), uniforms.end(), name,
+        [](const std::pair<std::string, GLint>& uniform, const char* key) { return uniform.first.compare(key) < 0; });
+    if (found == uniforms.end() || found->first.compare(name) != 0) return -1;
+    return found->second;
+}
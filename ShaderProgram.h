@@ -0,0 +1,62 @@
+#ifndef SHADERPROGRAM_H
+#define SHADERPROGRAM_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <GL/glew.h>
+#include "ProgramCache.h"
+
+class AssetPreloader;
+
+// Binding points of the uniform blocks every program shares (SceneUniforms)
+const GLuint CAMERA_BLOCK_BINDING = 0;      // uniform Camera { mat4 projection; mat4 view; }
+const GLuint LIGHTING_BLOCK_BINDING = 1;    // uniform Lighting { vec3 lightPos; vec3 viewPos; vec3 lightColor; }
+
+// A linked vertex + fragment program. Every active uniform's location is
+// looked up once after linking; callers fetch the ones they need at setup
+// and keep them, so nothing is looked up by name while drawing. Camera and
+// Lighting blocks, if the shaders declare them, are bound to the shared
+// binding points above.
+//
+// With a ProgramCache set, a program whose sources were linked before is
+// restored from its binary instead of compiled. loadFiles reads sources from
+// the mounted AssetPack, then from an AssetPreloader if one is set, and only
+// then opens the files.
+class ShaderProgram {
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    static void setBinaryCache(ProgramCache* cache);    // nullptr: always compile
+    static void setSourcePreloader(AssetPreloader* preloader);  // nullptr: read files from disk
+
+    bool loadFiles(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
+    bool loadSource(const char* vertexSource, const char* fragmentSource);
+
+    void use() const;
+    GLuint getId() const;
+    bool isValid() const;
+
+    // -1 if the program has no such active uniform (also for block members)
+    GLint getUniformLocation(const char* name) const;
+
+private:
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    static ProgramCache* binaryCache;
+    static AssetPreloader* sourcePreloader;
+
+    GLuint program = 0;
+    std::vector<std::pair<std::string, GLint>> uniforms;   // Sorted by name
+
+    bool build(const char* vertexSource, const char* fragmentSource, const std::string& vertexName, const std::string& fragmentName);
+    bool loadBinary(std::uint64_t key, const std::string& name);
+    void storeBinary(std::uint64_t key);
+    static GLuint compile(GLenum type, const char* source, const std::string& name);
+    bool link(GLuint vertexShader, GLuint fragmentShader, const std::string& name, bool retrievable);
+    void resolveUniforms();
+};
+
+#endif // SHADERPROGRAM_H
@@ -1,13 +1,18 @@
 #include "TestBed.h"
 #include <thread>
-#include <random>
+#include <atomic>
+#include <ctime>
+#include "Random.h"
 using seconds = std::chrono::duration<double>;
 #define km_conversion pow(10, -6)   / 3600 
 
+// One seed per run, one stream per thread
+static const std::uint64_t simulationSeed = static_cast<std::uint64_t>(std::time(0));
+static std::atomic<std::uint64_t> nextStream(0);
+
 double randomNumber() {
-    std::mt19937 generator(static_cast<unsigned int>(std::time(0)));
-    std::uniform_real_distribution<double> distribution(0.0, 1.0);
-    return distribution(generator);
+    thread_local Random generator(simulationSeed, nextStream++);
+    return generator.nextDouble();
 }
 void checkGear(Car* car) {
     double speedRandomizer = randomNumber();
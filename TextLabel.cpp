@@ -0,0 +1,116 @@
+#include "TextLabel.h"
+#include <cstdio>
+
+TextLabel::TextLabel(TextRenderer& renderer, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color)
+    : renderer(renderer), x(x), y(y), scale(scale), color(color) {
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    TextRenderer::setupVertexArray(VAO, VBO);
+}
+
+TextLabel::~TextLabel() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+}
+
+void TextLabel::setText(const std::string& newText) {
+    if (newText == text) return;
+    text = newText;
+    dirty = true;
+}
+
+void TextLabel::setText(const char* newText) {
+    if (text.compare(newText) == 0) return;
+    text = newText;
+    dirty = true;
+}
+
+void TextLabel::begin() {
+    pending.clear();
+}
+
+void TextLabel::append(const char* piece) {
+    pending += piece;
+}
+
+void TextLabel::append(const std::string& piece) {
+    pending += piece;
+}
+
+void TextLabel::append(long long value) {
+    char digits[24];
+    std::snprintf(digits, sizeof(digits), "%lld", value);
+    pending += digits;
+}
+
+void TextLabel::append(double value, int decimals) {
+    char digits[32];
+    if (decimals < 0) std::snprintf(digits, sizeof(digits), "%g", value);
+    else std::snprintf(digits, sizeof(digits), "%.*f", decimals, value);
+    pending += digits;
+}
+
+void TextLabel::end() {
+    if (pending == text) return;
+    text.swap(pending);     // Both keep their capacity for the next change
+    dirty = true;
+}
+
+void TextLabel::setPosition(GLfloat newX, GLfloat newY) {
+    if (newX == x && newY == y) return;
+    x = newX;
+    y = newY;
+    dirty = true;
+}
+
+void TextLabel::setColor(glm::vec3 newColor) {
+    color = newColor;
+}
+
+const std::string& TextLabel::getText() const {
+    return text;
+}
+
+void TextLabel::rebuild() {
+    // Laid out as one batch; text with more distinct glyphs than the font's
+    // page holds is cut short rather than split into several draws
+    vertices.clear();
+    cells.clear();
+    if (renderer.font) {
+        renderer.font->beginBatch();
+        GLfloat penX = x;
+        complete = renderer.appendQuads(text, 0, penX, y, scale, vertices, &cells) == text.size();
+        builtEvictions = renderer.font->getEvictionCount();
+    }
+    vertexCount = static_cast<GLsizei>(vertices.size() / 4);
+    dirty = false;
+    if (vertices.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (vertices.size() > vertexCapacity) {
+        vertexCapacity = vertices.size();
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertexCapacity, vertices.data(), GL_DYNAMIC_DRAW);
+    }
+    else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GLfloat) * vertices.size(), vertices.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TextLabel::draw() {
+    if (!renderer.font) return;
+    // Only the loss of one of our own glyphs forces a rebuild, and the glyphs
+    // are marked as drawn every frame so the font evicts other ones first;
+    // otherwise labels evict each other's glyphs and rebuild in a cycle.
+    // Text that was cut short tries again after any eviction.
+    Font& font = *renderer.font;
+    if (dirty || (complete ? font.cellsEvictedSince(cells, builtEvictions) : font.getEvictionCount() != builtEvictions)) rebuild();
+    else font.touchCells(cells);
+    if (vertexCount == 0) return;
+
+    renderer.useFor(color);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
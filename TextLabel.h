@@ -0,0 +1,62 @@
+#ifndef TEXTLABEL_H
+#define TEXTLABEL_H
+
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "TextRenderer.h"
+
+// Text that stays laid out on the GPU between frames. Drawing it is one
+// draw call with no layout; the vertices are rebuilt only when the content
+// changes (or the font had to evict one of its glyphs).
+//
+// Content is either set whole or built from pieces between begin() and
+// end(). Building reuses the label's buffers, so a label whose numbers
+// change every frame allocates nothing once it has reached its longest text.
+class TextLabel {
+public:
+    TextLabel(TextRenderer& renderer, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color);
+    ~TextLabel();
+
+    void setText(const std::string& text);
+    void setText(const char* text);
+
+    void begin();
+    void append(const char* text);
+    void append(const std::string& text);
+    void append(long long value);
+    void append(double value, int decimals);    // decimals < 0: shortest form
+    void end();                                 // Rebuilds only if the text changed
+
+    void setPosition(GLfloat x, GLfloat y);
+    void setColor(glm::vec3 color);
+
+    void draw();
+
+    const std::string& getText() const;
+
+private:
+    TextLabel(const TextLabel&) = delete;
+    TextLabel& operator=(const TextLabel&) = delete;
+
+    TextRenderer& renderer;
+    GLfloat x, y, scale;
+    glm::vec3 color;
+
+    std::string text;
+    std::string pending;                        // Content being built by append
+    bool dirty = true;
+    unsigned long long builtEvictions = 0;      // Font's eviction count at the last rebuild
+    bool complete = true;                       // Whole text fitted in the font's page
+    std::vector<int> cells;                     // Atlas cells the vertices sample
+
+    unsigned int VAO, VBO;
+    std::vector<GLfloat> vertices;
+    size_t vertexCapacity = 0;                  // Floats the VBO can hold
+    GLsizei vertexCount = 0;
+
+    void rebuild();
+};
+
+#endif // TEXTLABEL_H
@@ -1,174 +1,98 @@
 #include "TextRenderer.h"
-#include <ft2build.h>
-#include FT_FREETYPE_H
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-TextRenderer::TextRenderer(const std::string& fontPath, const std::string& vertexShaderPath, const std::string& fragmentShaderPath, int fontSize) {
+TextRenderer::TextRenderer(FontCache& fontCache, const std::string& fontPath, const std::string& vertexShaderPath, const std::string& fragmentShaderPath, int fontSize, Font::Mode mode) {
 
     // Kreiraj ejder program
-    shaderProgram = createShader(vertexShaderPath, fragmentShaderPath);
+    shader = fontCache.getShader(vertexShaderPath, fragmentShaderPath);
 
 
 
     // U?itaj karaktere iz fonta
-    loadCharacters(fontPath, fontSize);
+    if (mode == Font::DISTANCE_FIELD) {
+        font = fontCache.getFont(fontPath, Font::SDF_SIZE, mode);
+        glyphScale = (GLfloat)fontSize / Font::SDF_SIZE;
+    }
+    else {
+        font = fontCache.getFont(fontPath, fontSize, mode);
+    }
 
     // Kreiraj VAO i VBO za renderovanje teksta
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     std::cout << "VAO: " << VAO << ", VBO: " << VBO << std::endl;
-    glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+    vertexCapacity = 6 * 4 * 32;    // Room for 32 characters; grows with longer strings
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertexCapacity, nullptr, GL_DYNAMIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    setupVertexArray(VAO, VBO);
+
+    // The screen size and the atlas unit never change (the program is shared,
+    // but every renderer sets the same values)
+    glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 800.0f, -1.0f, 1.0f);
+    shader->use();
+    glUniformMatrix4fv(shader->getUniformLocation("projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform1i(shader->getUniformLocation("text"), 0);
+    glUseProgram(0);
+    textColorLoc = shader->getUniformLocation("textColor");
 }
 
 TextRenderer::~TextRenderer() {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
-    glDeleteProgram(shaderProgram);
 }
 
-unsigned int TextRenderer::compileShader(GLenum type, const std::string& source) {
-    unsigned int shader = glCreateShader(type);
-    const char* src = source.c_str();
-    glShaderSource(shader, 1, &src, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Shader compilation failed:\n" << infoLog << std::endl;
+// Next code point of a UTF-8 string; malformed bytes come out as U+FFFD
+static std::uint32_t nextCodepoint(const std::string& text, size_t& i) {
+    unsigned char lead = static_cast<unsigned char>(text[i++]);
+    if (lead < 0x80) return lead;
+
+    int length = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+    if (length < 0 || lead > 0xF4) return 0xFFFD;
+    std::uint32_t codepoint = lead & (0x3F >> length);
+    for (int k = 0; k < length; ++k) {
+        if (i >= text.size() || (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) return 0xFFFD;
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i++]) & 0x3F);
     }
-
-    return shader;
+    return codepoint;
 }
 
-unsigned int TextRenderer::createShader(const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
-    std::ifstream vsFile(vertexShaderPath);
-    std::ifstream fsFile(fragmentShaderPath);
-
-    if (!vsFile.is_open() || !fsFile.is_open()) {
-        std::cerr << "Failed to load shader files: " << vertexShaderPath << ", " << fragmentShaderPath << std::endl;
-        return 0;
-    }
-
-    std::stringstream vsStream, fsStream;
-    vsStream << vsFile.rdbuf();
-    fsStream << fsFile.rdbuf();
-
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vsStream.str());
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsStream.str());
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        std::cerr << "Shader program linking failed:\n" << infoLog << std::endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return program;
-}
-
-void TextRenderer::loadCharacters(const std::string& fontPath, int fontSize) {
-    FT_Library ft;
-    if (FT_Init_FreeType(&ft)) {
-        std::cerr << "ERROR::FREETYPE: Could not initialize FreeType Library" << std::endl;
-        return;
-    }
-
-    FT_Face face;
-    if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
-        std::cerr << "ERROR::FREETYPE: Failed to load font" << std::endl;
-        FT_Done_FreeType(ft);
-        return;
-    }
-
-    FT_Set_Pixel_Sizes(face, 0, fontSize);
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    for (unsigned char c = 0; c < 128; c++) {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-            std::cerr << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
-            continue;
-        }
-
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            face->glyph->advance.x
-        };
-        Characters.insert(std::pair<char, Character>(c, character));
+void TextRenderer::RenderText(const std::string& text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color) {
+    if (!font) return;
+
+    // Two triangles per character, all in one buffer. If the string needs
+    // more glyphs than fit on the font's page at once, it is drawn in parts.
+    vertices.clear();
+    font->beginBatch();
+    size_t done = appendQuads(text, 0, x, y, scale, vertices);
+    while (done < text.size()) {
+        drawVertices(vertices, color);
+        vertices.clear();
+        font->beginBatch();
+        size_t next = appendQuads(text, done, x, y, scale, vertices);
+        if (next == done) break;    // Not even one glyph fits
+        done = next;
     }
-
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    drawVertices(vertices, color);
 }
 
-void TextRenderer::RenderText(const std::string& text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color) {
-    glUseProgram(shaderProgram);
-
-    float width = 800.0f;
-    float height = 800.0f;
-
-    glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 800.0f, -1.0f, 1.0f);
-    GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
-
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+size_t TextRenderer::appendQuads(const std::string& text, size_t start, GLfloat& x, GLfloat y, GLfloat scale, std::vector<GLfloat>& out,
+                                 std::vector<int>* cells) {
+    if (!font) return text.size();
+    scale *= glyphScale;
 
-    glUniform3f(glGetUniformLocation(shaderProgram, "textColor"), color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    for (size_t i = start; i < text.size(); ) {
+        size_t glyphStart = i;
+        std::uint32_t codepoint = nextCodepoint(text, i);
 
-    for (const char& c : text) {
-
-        if (Characters.find(c) == Characters.end()) {
-            std::cerr << "WARNING::TEXT_RENDERER: Character '" << c
-                << "' (ASCII: " << static_cast<int>(c) << ") not found in Characters map." << std::endl;
-            continue; // Presko?i karakter
-        }
+        bool batchFull;
+        const Character* glyph = font->getGlyph(codepoint, batchFull);
+        if (batchFull) return glyphStart;
+        if (!glyph) continue;   // Not in the font
 
-        Character ch = Characters[c];
+        const Character& ch = *glyph;
 
         GLfloat xpos = x + ch.Bearing.x * scale;
         GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
@@ -176,27 +100,58 @@ void TextRenderer::RenderText(const std::string& text, GLfloat x, GLfloat y, GLf
         GLfloat w = ch.Size.x * scale;
         GLfloat h = ch.Size.y * scale;
 
-        GLfloat vertices[6][4] = {
-            { xpos,     ypos + h, 0.0f, 0.0f },
-            { xpos,     ypos,     0.0f, 1.0f },
-            { xpos + w, ypos,     1.0f, 1.0f },
+        if (w > 0.0f && h > 0.0f) {
+            const GLfloat quad[6][4] = {
+                { xpos,     ypos + h, ch.UvMin.x, ch.UvMin.y },
+                { xpos,     ypos,     ch.UvMin.x, ch.UvMax.y },
+                { xpos + w, ypos,     ch.UvMax.x, ch.UvMax.y },
+
+                { xpos,     ypos + h, ch.UvMin.x, ch.UvMin.y },
+                { xpos + w, ypos,     ch.UvMax.x, ch.UvMax.y },
+                { xpos + w, ypos + h, ch.UvMax.x, ch.UvMin.y }
+            };
+            out.insert(out.end(), &quad[0][0], &quad[0][0] + 6 * 4);
+            if (cells && ch.Cell >= 0) cells->push_back(ch.Cell);
+        }
 
-            { xpos,     ypos + h, 0.0f, 0.0f },
-            { xpos + w, ypos,     1.0f, 1.0f },
-            { xpos + w, ypos + h, 1.0f, 0.0f }
-        };
+        x += (ch.Advance >> 6) * scale;
+    }
+    return text.size();
+}
 
+void TextRenderer::setupVertexArray(unsigned int vao, unsigned int vbo) {
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
 
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+void TextRenderer::useFor(glm::vec3 color) {
+    shader->use();
+    glUniform3f(textColorLoc, color.x, color.y, color.z);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, font->getTexture());
+}
 
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+void TextRenderer::drawVertices(const std::vector<GLfloat>& quads, glm::vec3 color) {
+    if (quads.empty()) return;
 
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    useFor(color);
+    glBindVertexArray(VAO);
 
-        x += (ch.Advance >> 6) * scale;
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (quads.size() > vertexCapacity) {
+        vertexCapacity = quads.size();
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertexCapacity, quads.data(), GL_DYNAMIC_DRAW);
     }
+    else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GLfloat) * quads.size(), quads.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(quads.size() / 4));
 
     glBindVertexArray(0);
     glUseProgram(0);
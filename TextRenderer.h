@@ -2,33 +2,44 @@
 #define TEXTRENDERER_H
 
 #include <string>
-#include <map>
+#include <vector>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
-
-struct Character {
-    GLuint TextureID;
-    glm::ivec2 Size;
-    glm::ivec2 Bearing;
-    GLuint Advance;
-};
-
+#include "FontCache.h"
+
+// Draws UTF-8 text with a font from a FontCache: a whole string is one vertex
+// upload and one draw call. Renderers of the same font and size share its
+// glyphs, and renderers of the same shaders share the program.
+//
+// In Font::DISTANCE_FIELD mode (with text_sdf.frag) every renderer of a font
+// shares one bake at Font::SDF_SIZE, fontSize is only the size drawn at
+// scale 1, and any scale stays sharp.
 class TextRenderer {
 public:
-    TextRenderer(const std::string& fontPath, const std::string& vertexShaderPath, const std::string& fragmentShaderPath, int fontSize);
+    TextRenderer(FontCache& fontCache, const std::string& fontPath, const std::string& vertexShaderPath, const std::string& fragmentShaderPath, int fontSize, Font::Mode mode = Font::BITMAP);
     ~TextRenderer();
 
     void RenderText(const std::string& text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color);
 
 private:
-    unsigned int compileShader(GLenum type, const std::string& source);
-    unsigned int createShader(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
-    void loadCharacters(const std::string& fontPath, int fontSize);
-
-    unsigned int shaderProgram;
+    friend class TextLabel;
+
+    // Lays out text from byte start on, moving x along; returns where it
+    // stopped: text.size(), or the first glyph that needs a new batch.
+    // cells, if given, collects the atlas cells the quads sample.
+    size_t appendQuads(const std::string& text, size_t start, GLfloat& x, GLfloat y, GLfloat scale, std::vector<GLfloat>& out,
+                       std::vector<int>* cells = nullptr);
+    static void setupVertexArray(unsigned int vao, unsigned int vbo);
+    void useFor(glm::vec3 color);           // Program, color and atlas for a draw
+    void drawVertices(const std::vector<GLfloat>& quads, glm::vec3 color);
+
+    Font* font = nullptr;                   // Owned by the cache
+    GLfloat glyphScale = 1.0f;              // Font pixels to fontSize pixels
+    ShaderProgram* shader;                  // Owned by the cache
     unsigned int VAO, VBO;
-    std::map<char, Character> Characters;
+    GLint textColorLoc = -1;
+    std::vector<GLfloat> vertices;          // Reused between calls
+    size_t vertexCapacity = 0;              // Floats the VBO can hold
 };
 
 #endif // TEXTRENDERER_H
-
@@ -0,0 +1,287 @@
+#include "TextureFile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const char TEXTURE_MAGIC[4] = { 'D', 'T', 'E', 'X' };
+
+bool TextureFile::open(const char* path) {
+    close();
+    if (!file.open(path)) return false;
+    return parse(file.data(), file.size(), path);
+}
+
+bool TextureFile::open(const unsigned char* data, std::size_t size, const char* name) {
+    close();
+    return parse(data, size, name);
+}
+
+bool TextureFile::parse(const unsigned char* data, std::size_t size, const char* path) {
+    bytes = data;
+    if (size < sizeof(TextureFileHeader)) {
+        close();
+        return false;
+    }
+    header = reinterpret_cast<const TextureFileHeader*>(data);
+    if (std::memcmp(header->magic, TEXTURE_MAGIC, 4) != 0 || header->version != VERSION
+        || header->format < TEXTURE_RGB8 || header->format > TEXTURE_DXT5 || header->levelCount == 0
+        || size - sizeof(TextureFileHeader) < (std::size_t)header->levelCount * sizeof(TextureLevel)) {
+        std::cerr << "Not a baked texture: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    levels = reinterpret_cast<const TextureLevel*>(data + sizeof(TextureFileHeader));
+    std::uint32_t width = header->width, height = header->height;
+    for (std::uint32_t i = 0; i < header->levelCount; ++i) {
+        // The GL upload reads width x height worth of data, so the entry's
+        // dimensions must be the mip chain's and its size must match them
+        if (levels[i].width != width || levels[i].height != height || width == 0 || height == 0
+            || levels[i].size != levelSize(getFormat(), width, height)) {
+            std::cerr << "Not a baked texture: " << path << std::endl;
+            close();
+            return false;
+        }
+        if (levels[i].offset > size || levels[i].size > size - levels[i].offset) {
+            std::cerr << "Baked texture is truncated: " << path << std::endl;
+            close();
+            return false;
+        }
+        width = std::max<std::uint32_t>(1, width / 2);
+        height = std::max<std::uint32_t>(1, height / 2);
+    }
+    return true;
+}
+
+std::uint64_t TextureFile::levelSize(TextureFormat format, std::uint32_t width, std::uint32_t height) {
+    std::uint64_t blocks = (((std::uint64_t)width + 3) / 4) * (((std::uint64_t)height + 3) / 4);
+    switch (format) {
+    case TEXTURE_DXT1: return blocks * 8;
+    case TEXTURE_DXT5: return blocks * 16;
+    case TEXTURE_RGBA8: return (std::uint64_t)width * height * 4;
+    default: return (std::uint64_t)width * height * 3;
+    }
+}
+
+void TextureFile::close() {
+    file.close();
+    bytes = nullptr;
+    header = nullptr;
+    levels = nullptr;
+}
+
+TextureFormat TextureFile::getFormat() const {
+    return static_cast<TextureFormat>(header->format);
+}
+
+std::size_t TextureFile::getLevelCount() const {
+    return header ? header->levelCount : 0;
+}
+
+const TextureLevel& TextureFile::getLevel(std::size_t level) const {
+    return levels[level];
+}
+
+const unsigned char* TextureFile::getLevelData(std::size_t level) const {
+    return bytes + levels[level].offset;
+}
+
+bool TextureFile::isCompressed(TextureFormat format) {
+    return format == TEXTURE_DXT1 || format == TEXTURE_DXT5;
+}
+
+std::vector<TextureImage> buildMipChain(TextureImage base) {
+    std::vector<TextureImage> chain;
+    chain.push_back(std::move(base));
+
+    while (chain.back().width > 1 || chain.back().height > 1) {
+        const TextureImage& source = chain.back();
+        TextureImage next;
+        next.width = std::max(1, source.width / 2);
+        next.height = std::max(1, source.height / 2);
+        next.channels = source.channels;
+        next.pixels.resize((std::size_t)next.width * next.height * next.channels);
+
+        // Average of the 2x2 source texels (the last row or column of an odd
+        // size is folded into its neighbour's average by clamping)
+        for (int y = 0; y < next.height; ++y) {
+            int y0 = std::min(2 * y, source.height - 1), y1 = std::min(2 * y + 1, source.height - 1);
+            for (int x = 0; x < next.width; ++x) {
+                int x0 = std::min(2 * x, source.width - 1), x1 = std::min(2 * x + 1, source.width - 1);
+                for (int c = 0; c < next.channels; ++c) {
+                    int sum = source.pixels[((std::size_t)y0 * source.width + x0) * source.channels + c]
+                        + source.pixels[((std::size_t)y0 * source.width + x1) * source.channels + c]
+                        + source.pixels[((std::size_t)y1 * source.width + x0) * source.channels + c]
+                        + source.pixels[((std::size_t)y1 * source.width + x1) * source.channels + c];
+                    next.pixels[((std::size_t)y * next.width + x) * next.channels + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+        chain.push_back(std::move(next));
+    }
+    return chain;
+}
+
+static std::uint16_t toRgb565(const int color[3]) {
+    return (std::uint16_t)(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+}
+
+static void fromRgb565(std::uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// Colour half of a DXT1/DXT5 block: the endpoints are the block's bounding
+// box, pulled in by 1/16 so the interpolated colours cover the pixels better
+static void compressColorBlock(const unsigned char block[16][4], unsigned char* out) {
+    int low[3] = { 255, 255, 255 }, high[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            low[c] = std::min(low[c], (int)block[i][c]);
+            high[c] = std::max(high[c], (int)block[i][c]);
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        int inset = (high[c] - low[c]) / 16;
+        low[c] += inset;
+        high[c] -= inset;
+    }
+
+    std::uint16_t color0 = toRgb565(high), color1 = toRgb565(low);
+    if (color0 < color1) std::swap(color0, color1);     // color0 > color1: four-colour mode
+
+    std::uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        fromRgb565(color0, palette[0]);
+        fromRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDistance = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int distance = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int d = block[i][c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (std::uint32_t)best << (2 * i);
+        }
+    }
+
+    out[0] = color0 & 0xFF;
+    out[1] = color0 >> 8;
+    out[2] = color1 & 0xFF;
+    out[3] = color1 >> 8;
+    for (int i = 0; i < 4; ++i) out[4 + i] = (indices >> (8 * i)) & 0xFF;
+}
+
+// Alpha half of a DXT5 block: eight levels between the block's extremes
+static void compressAlphaBlock(const unsigned char block[16][4], unsigned char* out) {
+    int alpha0 = 0, alpha1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        alpha0 = std::max(alpha0, (int)block[i][3]);
+        alpha1 = std::min(alpha1, (int)block[i][3]);
+    }
+
+    std::uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        int palette[8] = { alpha0, alpha1 };
+        for (int p = 1; p < 7; ++p) palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            for (int p = 1; p < 8; ++p) {
+                if (std::abs(block[i][3] - palette[p]) < std::abs(block[i][3] - palette[best])) best = p;
+            }
+            indices |= (std::uint64_t)best << (3 * i);
+        }
+    }
+
+    out[0] = (unsigned char)alpha0;
+    out[1] = (unsigned char)alpha1;
+    for (int i = 0; i < 6; ++i) out[2 + i] = (indices >> (8 * i)) & 0xFF;
+}
+
+std::vector<unsigned char> compressBlocks(const TextureImage& image) {
+    bool alpha = image.channels == 4;
+    int blockBytes = alpha ? 16 : 8;
+    int blocksX = (image.width + 3) / 4, blocksY = (image.height + 3) / 4;
+    std::vector<unsigned char> out((std::size_t)blocksX * blocksY * blockBytes);
+
+    unsigned char block[16][4];
+    unsigned char* next = out.data();
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int i = 0; i < 16; ++i) {
+                int x = std::min(bx * 4 + i % 4, image.width - 1);
+                int y = std::min(by * 4 + i / 4, image.height - 1);
+                const unsigned char* pixel = &image.pixels[((std::size_t)y * image.width + x) * image.channels];
+                for (int c = 0; c < 4; ++c) block[i][c] = c < image.channels ? pixel[c] : 255;
+            }
+            if (alpha) {
+                compressAlphaBlock(block, next);
+                next += 8;
+            }
+            compressColorBlock(block, next);
+            next += 8;
+        }
+    }
+    return out;
+}
+
+bool writeTextureFile(const char* path, const std::vector<TextureImage>& levels, bool compress) {
+    if (levels.empty()) return false;
+    bool alpha = levels[0].channels == 4;
+
+    std::vector<std::vector<unsigned char>> compressed;
+    if (compress) {
+        for (const TextureImage& level : levels) compressed.push_back(compressBlocks(level));
+    }
+
+    TextureFileHeader header = {};
+    std::memcpy(header.magic, TEXTURE_MAGIC, 4);
+    header.version = TextureFile::VERSION;
+    header.format = compress ? (alpha ? TEXTURE_DXT5 : TEXTURE_DXT1) : (alpha ? TEXTURE_RGBA8 : TEXTURE_RGB8);
+    header.width = levels[0].width;
+    header.height = levels[0].height;
+    header.levelCount = (std::uint32_t)levels.size();
+
+    std::vector<TextureLevel> entries(levels.size());
+    std::uint64_t offset = sizeof(header) + entries.size() * sizeof(TextureLevel);
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        offset = (offset + 15) & ~(std::uint64_t)15;
+        entries[i].width = levels[i].width;
+        entries[i].height = levels[i].height;
+        entries[i].offset = offset;
+        entries[i].size = compress ? compressed[i].size() : levels[i].pixels.size();
+        offset += entries[i].size;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Could not write " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(TextureLevel));
+    std::uint64_t written = sizeof(header) + entries.size() * sizeof(TextureLevel);
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        static const char padding[16] = {};
+        out.write(padding, (std::streamsize)(entries[i].offset - written));
+        const std::vector<unsigned char>& data = compress ? compressed[i] : levels[i].pixels;
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        written = entries[i].offset + entries[i].size;
+    }
+    return (bool)out;
+}
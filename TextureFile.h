@@ -0,0 +1,87 @@
+#ifndef TEXTUREFILE_H
+#define TEXTUREFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// A baked texture (.dtex): every mip level in the layout the GPU takes it,
+// so loading is a map and one upload per level, with no decoding.
+//
+//   header (32 bytes), levelCount level entries (24 bytes), level data
+//
+// Level data starts 16-byte aligned; rows of uncompressed levels are tightly
+// packed (upload with GL_UNPACK_ALIGNMENT 1).
+enum TextureFormat : std::uint32_t {
+    TEXTURE_RGB8 = 1,
+    TEXTURE_RGBA8 = 2,
+    TEXTURE_DXT1 = 3,   // RGB, 8 bytes per 4x4 block
+    TEXTURE_DXT5 = 4    // RGBA, 16 bytes per 4x4 block
+};
+
+struct TextureFileHeader {
+    char magic[4];                  // "DTEX"
+    std::uint32_t version;
+    std::uint32_t format;           // TextureFormat
+    std::uint32_t width, height;    // Level 0
+    std::uint32_t levelCount;
+    std::uint32_t reserved[2];
+};
+
+struct TextureLevel {
+    std::uint32_t width, height;
+    std::uint64_t offset;           // From the start of the file
+    std::uint64_t size;             // Bytes
+};
+
+static_assert(sizeof(TextureFileHeader) == 32, "texture file header must stay 32 bytes");
+static_assert(sizeof(TextureLevel) == 24, "texture level entries must stay 24 bytes");
+
+// An uncompressed image, rows top to bottom
+struct TextureImage {
+    int width = 0, height = 0;
+    int channels = 0;               // 3 or 4
+    std::vector<unsigned char> pixels;
+};
+
+// Maps a .dtex file, or reads one already in memory (an AssetPack view);
+// level data is read straight from the mapping
+class TextureFile {
+public:
+    static const std::uint32_t VERSION = 1;
+
+    bool open(const char* path);    // False if missing, truncated or not a .dtex
+    // The bytes must stay valid while the file is open; name is for errors
+    bool open(const unsigned char* data, std::size_t size, const char* name);
+    void close();
+
+    TextureFormat getFormat() const;
+    std::size_t getLevelCount() const;
+    const TextureLevel& getLevel(std::size_t level) const;
+    const unsigned char* getLevelData(std::size_t level) const;
+
+    static bool isCompressed(TextureFormat format);
+    static std::uint64_t levelSize(TextureFormat format, std::uint32_t width, std::uint32_t height);  // Bytes
+
+private:
+    MappedFile file;
+    const unsigned char* bytes = nullptr;
+    const TextureFileHeader* header = nullptr;
+    const TextureLevel* levels = nullptr;
+
+    bool parse(const unsigned char* data, std::size_t size, const char* path);
+};
+
+// Baking (offline, see tools/BakeTextures.cpp)
+
+// Level 0 followed by box-filtered halvings down to 1x1
+std::vector<TextureImage> buildMipChain(TextureImage base);
+
+// DXT1 for 3 channels, DXT5 for 4; partial edge blocks repeat edge pixels
+std::vector<unsigned char> compressBlocks(const TextureImage& image);
+
+bool writeTextureFile(const char* path, const std::vector<TextureImage>& levels, bool compress);
+
+#endif // TEXTUREFILE_H
@@ -0,0 +1,130 @@
+#include "TextureLoader.h"
+#include <GL/glew.h>
+#include <iostream>
+#include <string>
+#include "AssetPack.h"
+#include "AssetPreloader.h"
+#include "stb_image.h"
+
+static AssetPreloader* preloader = nullptr;
+
+void setTexturePreloader(AssetPreloader* assets) {
+    preloader = assets;
+}
+
+static std::string bakedPath(const char* imagePath) {
+    std::string path = imagePath;
+    std::string::size_type dot = path.find_last_of('.');
+    std::string::size_type slash = path.find_last_of("/\\");
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) path.erase(dot);
+    return path + ".dtex";
+}
+
+static bool decodeImage(const char* imagePath, TextureImage& image) {
+    AssetView view;
+    unsigned char* data = findAsset(imagePath, view)
+        ? stbi_load_from_memory(view.data, (int)view.size, &image.width, &image.height, &image.channels, 0)
+        : stbi_load(imagePath, &image.width, &image.height, &image.channels, 0);
+    if (!data) return false;
+    image.pixels.assign(data, data + (std::size_t)image.width * image.height * image.channels);
+    stbi_image_free(data);
+    return true;
+}
+
+bool prepareTexture(const char* imagePath, PreparedTexture& texture) {
+    texture.imagePath = imagePath;
+    std::string baked = bakedPath(imagePath);
+    AssetView view;
+    texture.isBaked = findAsset(baked, view) ? texture.baked.open(view.data, view.size, baked.c_str()) : texture.baked.open(baked.c_str());
+    if (texture.isBaked) {
+        // Fault the mapping in here rather than inside glTexImage2D
+        volatile unsigned char sum = 0;
+        for (std::size_t i = 0; i < texture.baked.getLevelCount(); ++i) {
+            const unsigned char* data = texture.baked.getLevelData(i);
+            std::size_t size = (std::size_t)texture.baked.getLevel(i).size;
+            for (std::size_t offset = 0; offset < size; offset += 4096) sum += data[offset];
+        }
+        return true;
+    }
+    return decodeImage(imagePath, texture.image);
+}
+
+static bool uploadBaked(const TextureFile& file) {
+    TextureFormat format = file.getFormat();
+    if (TextureFile::isCompressed(format) && !GLEW_EXT_texture_compression_s3tc) return false;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (std::size_t i = 0; i < file.getLevelCount(); ++i) {
+        const TextureLevel& level = file.getLevel(i);
+        const unsigned char* data = file.getLevelData(i);
+        switch (format) {
+        case TEXTURE_DXT1:
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, level.width, level.height, 0, (GLsizei)level.size, data);
+            break;
+        case TEXTURE_DXT5:
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, level.width, level.height, 0, (GLsizei)level.size, data);
+            break;
+        case TEXTURE_RGBA8:
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_RGBA, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+            break;
+        default:
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_RGB, level.width, level.height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+            break;
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)file.getLevelCount() - 1);
+    return true;
+}
+
+static void uploadImage(const TextureImage& image) {
+    GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+unsigned int uploadTexture(PreparedTexture& texture) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    bool loaded = texture.isBaked && uploadBaked(texture.baked);
+    if (!loaded && texture.isBaked) {
+        texture.isBaked = false;
+        texture.baked.close();
+        decodeImage(texture.imagePath.c_str(), texture.image);
+    }
+    if (!loaded && !texture.image.pixels.empty()) {
+        uploadImage(texture.image);
+        loaded = true;
+    }
+    if (!loaded) {
+        std::cout << "Failed to load texture: " << texture.imagePath << std::endl;
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &textureID);
+        return 0;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return textureID;
+}
+
+unsigned int loadTexture(const char* imagePath) {
+    PreparedTexture* preloaded = preloader ? preloader->takeTexture(imagePath) : nullptr;
+    if (preloaded) {
+        unsigned int textureID = uploadTexture(*preloaded);
+        preloaded->baked.close();
+        preloaded->image = TextureImage();
+        return textureID;
+    }
+
+    PreparedTexture texture;
+    prepareTexture(imagePath, texture);
+    return uploadTexture(texture);
+}
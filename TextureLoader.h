@@ -0,0 +1,35 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include "TextureFile.h"
+
+class AssetPreloader;
+
+// The CPU half of a texture load: a mapped .dtex, or the decoded image
+struct PreparedTexture {
+    std::string imagePath;
+    TextureFile baked;
+    bool isBaked = false;
+    TextureImage image;         // When not baked
+};
+
+// Maps "<name>.dtex" next to the image (touching every page, so the upload
+// does not wait on the disk) or else decodes the image; either is taken
+// from the mounted AssetPack first. No GL calls; safe on any thread. False
+// if neither can be read.
+bool prepareTexture(const char* imagePath, PreparedTexture& texture);
+
+// Creates a GL texture (REPEAT wrap, LINEAR filtering) from a prepared one:
+// the baked mip levels as they are, or the image with glGenerateMipmap.
+// A compressed bake the GPU cannot take is replaced by the image. 0 on failure.
+unsigned int uploadTexture(PreparedTexture& texture);
+
+// prepareTexture and uploadTexture, or uploadTexture of the preloader's copy
+// when one is set (see setTexturePreloader)
+unsigned int loadTexture(const char* imagePath);
+
+// Textures loaded while set come from the preloader when it has them;
+// nullptr: always read from disk
+void setTexturePreloader(AssetPreloader* preloader);
+
+#endif // TEXTURELOADER_H
@@ -0,0 +1,164 @@
+#include "ThrowLog.h"
+#include "ThrowState.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+static const char MAGIC[4] = { 'D', 'T', 'L', 'G' };
+static const std::uint32_t VERSION = 1;
+
+struct ThrowLogHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(ThrowLogHeader) == 16, "log header must stay 16 bytes");
+static_assert(sizeof(ThrowLogHeader) % alignof(ThrowRecord) == 0, "records must stay aligned in the mapped file");
+
+static bool isValidHeader(const ThrowLogHeader& header) {
+    return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION
+        && header.recordSize == sizeof(ThrowRecord);
+}
+
+ThrowLogWriter::ThrowLogWriter() : recordCount(0) {
+}
+
+ThrowLogWriter::~ThrowLogWriter() {
+    close();
+}
+
+bool ThrowLogWriter::open(const char* path) {
+    close();
+
+    // Existing log: check it is ours and find the end of the last whole record
+    unsigned long long existingSize = 0;
+    ThrowLogHeader header;
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (in.is_open()) {
+            existingSize = (unsigned long long)in.tellg();
+            in.seekg(0);
+            if (existingSize > 0) {
+                in.read(reinterpret_cast<char*>(&header), sizeof(ThrowLogHeader));
+                if (!in || !isValidHeader(header)) {
+                    std::cerr << "Error: Not a throw log (or an old version): " << path << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    if (existingSize > 0) {
+        out.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        recordCount = (existingSize - sizeof(ThrowLogHeader)) / sizeof(ThrowRecord);
+        out.seekp((std::streamoff)(sizeof(ThrowLogHeader) + recordCount * sizeof(ThrowRecord)));
+    }
+    else {
+        out.open(path, std::ios::binary | std::ios::trunc);
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.recordSize = sizeof(ThrowRecord);
+        header.reserved = 0;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(ThrowLogHeader));
+        recordCount = 0;
+    }
+
+    if (!out.good()) {
+        std::cerr << "Error: Could not open throw log: " << path << std::endl;
+        out.close();
+        return false;
+    }
+    return true;
+}
+
+void ThrowLogWriter::close() {
+    if (out.is_open()) out.close();
+}
+
+bool ThrowLogWriter::isOpen() const {
+    return out.is_open();
+}
+
+void ThrowLogWriter::append(const ThrowRecord& record) {
+    if (!out.is_open()) return;
+    out.write(reinterpret_cast<const char*>(&record), sizeof(ThrowRecord));
+    ++recordCount;
+}
+
+void ThrowLogWriter::append(const ThrowState& state) {
+    ThrowRecord record;
+    record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.tick = (std::uint32_t)state.tick;
+    record.crosshairX = state.crosshairX;
+    record.crosshairY = state.crosshairY;
+    record.boardX = state.boardX;
+    record.boardY = state.boardY;
+    record.player = (std::uint8_t)state.player;
+    record.score = (std::uint8_t)state.score;
+    record.dartsLeft = (std::uint8_t)state.dartsLeft;
+    record.result = (std::uint8_t)state.result;
+    append(record);
+}
+
+void ThrowLogWriter::flush() {
+    if (out.is_open()) out.flush();
+}
+
+unsigned long long ThrowLogWriter::getRecordCount() const {
+    return recordCount;
+}
+
+ThrowLogReader::ThrowLogReader() : records(nullptr), count(0) {
+}
+
+bool ThrowLogReader::open(const char* path) {
+    close();
+    if (!file.open(path)) return false;
+
+    ThrowLogHeader header;
+    if (file.size() < sizeof(ThrowLogHeader)) {
+        std::cerr << "Error: Throw log is too short: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(ThrowLogHeader));
+    if (!isValidHeader(header)) {
+        std::cerr << "Error: Not a throw log (or an old version): " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    // A torn record at the end (crash mid-write) is left out
+    count = (file.size() - sizeof(ThrowLogHeader)) / sizeof(ThrowRecord);
+    records = reinterpret_cast<const ThrowRecord*>(file.data() + sizeof(ThrowLogHeader));
+    return true;
+}
+
+void ThrowLogReader::close() {
+    file.close();
+    records = nullptr;
+    count = 0;
+}
+
+bool ThrowLogReader::isOpen() const {
+    return file.isOpen();
+}
+
+std::size_t ThrowLogReader::size() const {
+    return count;
+}
+
+const ThrowRecord& ThrowLogReader::operator[](std::size_t index) const {
+    return records[index];
+}
+
+const ThrowRecord* ThrowLogReader::begin() const {
+    return records;
+}
+
+const ThrowRecord* ThrowLogReader::end() const {
+    return records + count;
+}
@@ -0,0 +1,74 @@
+#ifndef THROWLOG_H
+#define THROWLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <type_traits>
+#include "MappedFile.h"
+
+struct ThrowState;
+
+// One throw, exactly as it sits in the log file (little-endian)
+struct ThrowRecord {
+    std::int64_t timestamp;         // Microseconds since the Unix epoch
+    std::uint32_t tick;             // Game tick of the throw
+    float crosshairX, crosshairY;   // NDC
+    float boardX, boardY;           // Board space
+    std::uint8_t player;
+    std::uint8_t score;
+    std::uint8_t dartsLeft;         // After this throw
+    std::uint8_t result;            // X01Rules::Result
+};
+
+static_assert(sizeof(ThrowRecord) == 32, "throw records must stay 32 bytes");
+static_assert(std::is_trivially_copyable<ThrowRecord>::value, "throw records are written as raw bytes");
+
+// Appends fixed-size records to a throw log, creating it if needed. Writes
+// are buffered; call flush() at natural breaks (end of a turn) to bound what
+// a crash can lose. A record torn by a crash is overwritten by the next one.
+class ThrowLogWriter {
+public:
+    ThrowLogWriter();
+    ~ThrowLogWriter();
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const;
+
+    void append(const ThrowRecord& record);
+    void append(const ThrowState& state);   // Stamped with the current time
+    void flush();
+
+    unsigned long long getRecordCount() const;  // Including records already in the file
+
+private:
+    ThrowLogWriter(const ThrowLogWriter&) = delete;
+    ThrowLogWriter& operator=(const ThrowLogWriter&) = delete;
+
+    std::ofstream out;
+    unsigned long long recordCount;
+};
+
+// Maps a throw log and hands out its records in place, without copying or
+// parsing. Records appended after open() are not seen until it is reopened.
+class ThrowLogReader {
+public:
+    ThrowLogReader();
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const;
+
+    std::size_t size() const;
+    const ThrowRecord& operator[](std::size_t index) const;
+    const ThrowRecord* begin() const;
+    const ThrowRecord* end() const;
+
+private:
+    MappedFile file;
+    const ThrowRecord* records;
+    std::size_t count;
+};
+
+#endif // THROWLOG_H
@@ -0,0 +1,18 @@
+#ifndef THROWSTATE_H
+#define THROWSTATE_H
+
+#include <cstdint>
+
+// One throw as the game reports it. Kept apart from Game.h so the throw log
+// and its tools build without glm.
+struct ThrowState {
+    std::uint64_t tick;
+    int player;
+    float crosshairX, crosshairY;   // NDC
+    float boardX, boardY;           // Board space
+    int score;
+    int dartsLeft;                  // After this throw
+    int result;                     // X01Rules::Result
+};
+
+#endif // THROWSTATE_H
@@ -0,0 +1,50 @@
+#ifndef X01RULES_H
+#define X01RULES_H
+
+#include "BoardScorer.h"
+
+// How a single dart changes the score still needed in a game of x01
+struct X01Rules {
+    enum Result {
+        SCORED,     // Remaining score went down, turn continues
+        FINISHED,   // Remaining score reached zero
+        IGNORED,    // Dart did not count, turn continues
+        BUST        // Dart did not count and the turn is over
+    };
+
+    int startScore;
+    bool doubleOut;     // The finishing dart must be a double or the bullseye
+
+    // What Player::addScore does: count up to exactly 501, a dart that would
+    // go past it is ignored
+    static X01Rules house() { return { 501, false }; }
+
+    // Tournament 501: finish on a double, going below two is a bust
+    static X01Rules tournament() { return { 501, true }; }
+
+    Result apply(int remaining, const BoardSegment& hit, int& newRemaining) const {
+        newRemaining = remaining;
+        int left = remaining - hit.score();
+        if (doubleOut) {
+            if (left == 0 && hit.multiplier == 2) {
+                newRemaining = 0;
+                return FINISHED;
+            }
+            if (left < 2) return BUST;
+        }
+        else {
+            if (left < 0) return IGNORED;
+            if (left == 0) {
+                newRemaining = 0;
+                return FINISHED;
+            }
+        }
+        newRemaining = left;
+        return SCORED;
+    }
+
+    // Lowest remaining score a player can still finish from
+    int minimumCheckout() const { return doubleOut ? 2 : 1; }
+};
+
+#endif // X01RULES_H
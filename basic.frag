@@ -6,9 +6,12 @@ in vec2 TexCoord;
 out vec4 FragColor;
 
 uniform sampler2D dartboardTexture;
-uniform vec3 lightPos;
-uniform vec3 viewPos;
-uniform vec3 lightColor;
+
+layout(std140) uniform Lighting {
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+};
 
 void main() {
     vec3 objectColor = texture(dartboardTexture, TexCoord).rgb;
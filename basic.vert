@@ -8,8 +8,11 @@ out vec3 Normal;
 out vec2 TexCoord;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+layout(std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 
 void main() {
     FragPos = vec3(model * vec4(aPos, 1.0));
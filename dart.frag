@@ -4,10 +4,13 @@ in vec3 Normal;
 
 out vec4 FragColor;
 
-uniform vec3 lightPos;
-uniform vec3 viewPos;
 uniform vec3 objectColor;
-uniform vec3 lightColor;
+
+layout(std140) uniform Lighting {
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+};
 
 void main() {
     // Ambient
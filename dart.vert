@@ -1,16 +1,19 @@
 #version 330 core
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
+layout(location = 2) in mat4 instanceModel;   // One per dart, locations 2-5
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 
 out vec3 FragPos;
 out vec3 Normal;
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    FragPos = vec3(instanceModel * vec4(aPos, 1.0));
+    // Darts are only moved and rotated, so the model matrix rotates normals too
+    Normal = mat3(instanceModel) * aNormal;
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
\ No newline at end of file
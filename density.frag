@@ -0,0 +1,21 @@
+#version 330 core
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoord;
+
+out vec4 FragColor;
+
+uniform sampler2D densityTexture;
+uniform float maxValue;
+
+void main() {
+    // The board texture has its first row at the top, the density texture at the bottom
+    float value = texture(densityTexture, vec2(TexCoord.x, 1.0 - TexCoord.y)).r / maxValue;
+    value = clamp(value, 0.0, 1.0);
+    if (value < 0.01) discard;
+
+    // Dark purple (rare) -> orange -> yellow (most hits); rare spots fade out
+    vec3 color = mix(vec3(0.3, 0.0, 0.5), vec3(1.0, 0.4, 0.0), smoothstep(0.0, 0.5, value));
+    color = mix(color, vec3(1.0, 1.0, 0.3), smoothstep(0.5, 1.0, value));
+    FragColor = vec4(color, 0.35 + 0.45 * value);
+}
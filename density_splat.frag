@@ -0,0 +1,10 @@
+#version 330 core
+out vec4 FragColor;
+
+void main() {
+    // The point sprite spans three standard deviations each way
+    vec2 offset = (gl_PointCoord - 0.5) * 6.0;
+    float distanceSquared = dot(offset, offset);
+    if (distanceSquared > 9.0) discard;
+    FragColor = vec4(exp(-0.5 * distanceSquared), 0.0, 0.0, 0.0);
+}
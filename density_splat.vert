@@ -0,0 +1,11 @@
+#version 330 core
+layout(location = 0) in vec2 aHit;     // Board space
+
+uniform float boardRadius;
+uniform float pointSize;
+
+void main() {
+    // The density texture covers [-boardRadius, boardRadius] in x and y
+    gl_Position = vec4(aHit / boardRadius, 0.0, 1.0);
+    gl_PointSize = pointSize;
+}
@@ -0,0 +1,20 @@
+#version 330 core
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoord;
+
+out vec4 FragColor;
+
+uniform sampler2D heatmapTexture;
+uniform float maxValue;
+
+void main() {
+    // The board texture has its first row at the top, the heatmap at the bottom
+    float value = texture(heatmapTexture, vec2(TexCoord.x, 1.0 - TexCoord.y)).r / maxValue;
+    value = clamp(value, 0.0, 1.0);
+
+    // Blue (low) -> green -> red (high)
+    vec3 color = mix(vec3(0.0, 0.2, 1.0), vec3(0.0, 1.0, 0.2), smoothstep(0.0, 0.5, value));
+    color = mix(color, vec3(1.0, 0.1, 0.0), smoothstep(0.5, 1.0, value));
+    FragColor = vec4(color, 0.55);
+}
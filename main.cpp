@@ -12,46 +12,142 @@
 #include "stb_image.h"
 #include <iostream>
 #include "Crosshair.h"
-#include "Player.h"
+#include "Game.h"
 #include "Background.h"
 #include "TextRenderer.h"
+#include "TextLabel.h"
+#include "ShaderProgram.h"
+#include "ProgramCache.h"
+#include "AssetPack.h"
+#include "AssetPreloader.h"
+#include "TextureLoader.h"
+#include "SceneUniforms.h"
+#include "SceneCache.h"
 #include "Overlay.h" // Assuming you have an Overlay class
-
-
-
-void processInput(GLFWwindow* window);
-void updateGame(float deltaTime, GLFWwindow* window, Dartboard& dartboard, TextRenderer& textRenderer, const glm::mat4& projection, const glm::mat4& view);
-void processThrow(Player& currentPlayer, Dartboard& dartboard, const glm::mat4& projection, const glm::mat4& view);
+#include "ExpectedScoreMap.h"
+#include "CheckoutTable.h"
+#include "HeadlessRunner.h"
+#include "ThrowLog.h"
+#include "ReplayEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+
+
+void processInput(GLFWwindow* window, Game& game, Dartboard& dartboard);
+void processReplayInput(GLFWwindow* window, ReplayEngine& replay, Dartboard& dartboard);
+void resyncScene(Dartboard& dartboard);
+bool keyPressedOnce(GLFWwindow* window, int key);
+void syncScene(const Game& game, Dartboard& dartboard, GLFWwindow* window);
+struct HudLabels;
+void renderHud(const Game& game, HudLabels& hud);
+void renderReplayHud(const ReplayEngine& replay, HudLabels& hud);
 void checkOpenGLError(const char* description);
+bool sceneIsIdle(const Game& shown, const ReplayEngine& replay);
+void cursorPosCallback(GLFWwindow*, double, double);
+void mouseButtonCallback(GLFWwindow*, int, int, int);
+void keyCallback(GLFWwindow*, int, int, int, int);
+struct IdleStats;
+void printIdleStats(const IdleStats& stats, double now);
 
 // Game objects
-Player player1("Player 1");
-Player player2("Player 2");
 Crosshair crosshair;
 
-int currentPlayer = 0;  // 0 for player1, 1 for player2
 float lastTime = 0.0f;
-bool throwProcessed = false; // Prevent multiple frames registering a click
-bool isPaused = false;       // Tracks whether the game is paused
 unsigned int rectangleVAO;       // VAO for the rectangle
-unsigned int rectangleShader;    // Shader program for the rectangle
+ShaderProgram rectangleShader;   // Shader program for the rectangle
 
 // Rectangle position and size (in NDC space)
 const float rectX = 360.0f; // X position in NDC space
 const float rectY = 390.0f; // Y position in NDC space
 const float rectWidth = 0.4f; // Width in NDC
 const float rectHeight = 0.2f; // Height in NDC
-float zoomLevel = 1.0f;
-float zoomFactor = 1.0f; // Zoom factor for the dartboard
 
-float targetZoomLevel = 1.0f;
-float currentZoomLevel = 1.0f;
-float zoomSpeed = 0.1f; // Adjust the speed of zooming
+const float NAME_SCALE = 20.0f / 48.0f; // Author credits are drawn at 20px
+
+// Retained HUD text: laid out once, rebuilt only when its content changes
+struct HudLabels {
+    explicit HudLabels(TextRenderer& renderer)
+        : score(renderer, 0.0f, 30.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f)),
+          dartsLeft(renderer, -0.9f, 0.8f, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f)),
+          hint(renderer, 0.0f, 80.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.6f)),
+          replay(renderer, 0.0f, 120.0f, 0.5f, glm::vec3(0.6f, 0.8f, 1.0f)),
+          studentId(renderer, 0.0f, 780.0f, NAME_SCALE, glm::vec3(1.0f, 1.0f, 1.0f)),
+          studentName(renderer, 0.0f, 760.0f, NAME_SCALE, glm::vec3(1.0f, 1.0f, 1.0f)),
+          quit(renderer, 0.0f, 0.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f)) {
+        studentId.setText("RA 156/2021");
+        studentName.setText("Strahinja Galic");
+    }
+
+    TextLabel score, dartsLeft, hint, replay, studentId, studentName, quit;
+};
+
+// What the scene currently shows of the game state
+struct SceneSync {
+    std::uint64_t throwCount = 0;
+    int dartCount = 0;
+    int roundNumber = 1;
+    int activePlayer = 0;
+    bool finished = false;
+};
+SceneSync sceneSync;
+
+// --replay FILE shows a logged match instead of a live one
+bool replayMode = false;
+
+// Expected-score overlay (E toggles, [ and ] change the throw spread)
+bool showExpectedScore = false;
+bool expectedScoreDirty = false;
+float throwSigma = 0.02f;           // Standard deviation of a throw in board units
+const float MIN_THROW_SIGMA = 0.004f;
+const float MAX_THROW_SIGMA = 0.08f;
+
+// Aim hints, solved once for the house rules and cached next to the executable
+CheckoutTable checkoutTable;
+const char* CHECKOUT_TABLE_PATH = "checkout.tbl";
+const float CHECKOUT_SIGMA = 0.02f;
+
+// Every throw is appended here for the nightly stats jobs
+ThrowLogWriter throwLog;
+const char* THROW_LOG_PATH = "throws.dtl";
+
+// Linked shader programs from earlier runs (invalidated by source or driver changes)
+ProgramCache programCache;
+const char* PROGRAM_CACHE_PATH = "shaders.cache";
+
+// Every asset file in one mapped archive (tools/PackAssets); loose files are
+// used when it is missing or lacks a file
+const char* ASSET_PACK_PATH = "assets.pak";
+
+// Read ahead on worker threads at startup (AssetPreloader)
+const std::vector<std::string> SCENE_SHADER_FILES = {
+    "basic.vert", "basic.frag", "heatmap.frag", "dart.vert", "dart.frag",
+    "density_splat.vert", "density_splat.frag", "density.frag",
+    "overlay.vert", "overlay.frag", "button.vert", "button.frag", "text.vert", "text_sdf.frag"
+};
+const char* HUD_FONT_PATH = "Jaro-Regular.ttf";
 
 
 const float TARGET_FPS = 60.0f;
 const float TARGET_FRAME_TIME = 1.0f / TARGET_FPS;
 
+// Idle mode: while nothing on screen can move without input, the loop
+// blocks in glfwWaitEvents instead of drawing the same frame at 60 FPS
+bool idleMode = true;                       // --no-idle turns it off
+const double IDLE_AFTER_SECONDS = 30.0;     // Without input, while playing
+const float IDLE_TIMER_SLICE = 0.2f;        // Longest wait while a game timer runs (Game::update catches up 0.25 s at most)
+const double IDLE_REPORT_SECONDS = 600.0;
+double lastInputTime = 0.0;
+
+// Time spent blocked since the last report
+struct IdleStats {
+    double start = 0.0;
+    double idle = 0.0;
+    unsigned long long frames = 0;
+    unsigned long long wakeups = 0;
+};
+
 
 
 
@@ -111,59 +207,8 @@ unsigned int createRectangleVAO() {
 
 
 
-unsigned int createShaderProgram(const char* vertexSource, const char* fragmentSource) {
-    // Compile Vertex Shader
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexSource, nullptr);
-    glCompileShader(vertexShader);
-
-    // Check for compile errors
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-
-    // Compile Fragment Shader
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    // Check for compile errors
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-
-    // Link Shaders into Program
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    // Check for linking errors
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-    }
-
-    // Cleanup
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
-}
-
-
-
-
-
-void renderRectangle(TextRenderer& textRenderer) {
-    glUseProgram(rectangleShader);
+void renderRectangle(TextLabel& quitLabel) {
+    rectangleShader.use();
     glBindVertexArray(rectangleVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6); // Draw 6 vertices (2 triangles)
     glBindVertexArray(0);
@@ -185,7 +230,9 @@ void renderRectangle(TextRenderer& textRenderer) {
     float textY = rectY + rectHeight / 2.0f + 0.05f; // Place text above the rectangle (with some gap)
 
     // Render the "Quit" text inside the rectangle
-    textRenderer.RenderText("Quit", textX, textY, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f));
+    quitLabel.setText("Quit");
+    quitLabel.setPosition(textX, textY);
+    quitLabel.draw();
 }
 
 void checkQuitClick(GLFWwindow* window) {
@@ -213,7 +260,77 @@ void checkQuitClick(GLFWwindow* window) {
 }
 
 
-int main() {
+int main(int argc, char** argv) {
+    // --headless plays scripted matches without creating a window
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--headless") return runHeadless(argc, argv);
+    }
+
+    // Shader sources, textures and the HUD glyphs are read on worker threads
+    // while the window and GL context are created; only uploads wait for them
+    auto startupStart = std::chrono::steady_clock::now();
+    bool firstFrame = true;
+    AssetPack assetPack;
+    if (assetPack.open(ASSET_PACK_PATH)) {
+        AssetPack::mount(&assetPack);
+        std::cout << "Assets: " << assetPack.getFileCount() << " files from " << ASSET_PACK_PATH << std::endl;
+    }
+    AssetPreloader assets;
+    assets.addShaderFiles(SCENE_SHADER_FILES);
+    assets.addTexture("barBackground.jpg");
+    assets.addTexture("Dartboard.png");
+    assets.addGlyphs(HUD_FONT_PATH, Font::SDF_SIZE, Font::SDF_SPREAD, 32, 126);
+
+    // --seed N replays the shake of an earlier game
+    std::uint64_t matchSeed = (std::uint64_t)std::chrono::system_clock::now().time_since_epoch().count();
+    // --replay FILE [--match N] [--turn T] [--speed S] [--double-out]
+    const char* replayPath = nullptr;
+    long replayMatch = -1;              // Counted from the end of the log: -1 is the latest match
+    unsigned long replayTurn = 0;
+    float replaySpeed = 1.0f;
+    X01Rules replayRules = X01Rules::house();
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--seed" && hasValue) matchSeed = std::strtoull(argv[++i], nullptr, 10);
+        else if (argument == "--replay" && hasValue) replayPath = argv[++i];
+        else if (argument == "--match" && hasValue) replayMatch = std::strtol(argv[++i], nullptr, 10);
+        else if (argument == "--turn" && hasValue) replayTurn = std::strtoul(argv[++i], nullptr, 10);
+        else if (argument == "--speed" && hasValue) replaySpeed = (float)std::atof(argv[++i]);
+        else if (argument == "--double-out") replayRules = X01Rules::tournament();
+        else if (argument == "--no-idle") idleMode = false;
+    }
+    Game game(matchSeed);
+
+    ThrowLogReader replayLog;
+    ReplayEngine replay(replayRules);
+    if (replayPath) {
+        if (!replayLog.open(replayPath)) {
+            std::cout << "Failed to open replay: " << replayPath << std::endl;
+            return -1;
+        }
+        std::vector<ReplayMatch> matches = ReplayEngine::findMatches(replayLog);
+        long index = replayMatch < 0 ? (long)matches.size() + replayMatch : replayMatch;
+        if (index < 0 || index >= (long)matches.size()) {
+            std::cout << "The log has " << matches.size() << " matches" << std::endl;
+            return -1;
+        }
+        std::size_t mismatches = replay.load(replayLog.begin() + matches[index].first, matches[index].count);
+        if (mismatches) {
+            std::cout << "Warning: " << mismatches << " throws score differently than when they were logged"
+                      << " (played with other rules? try --double-out)" << std::endl;
+        }
+        replay.setSpeed(replaySpeed);
+        replay.seekTurn(replayTurn);
+        replayMode = true;
+        std::cout << "Replaying match " << index << ": " << replay.getThrowCount() << " throws, "
+                  << replay.getTurnCount() << " turns" << std::endl;
+        std::cout << "Space: play/pause, Left/Right: turn, Page Up/Down: 10 turns, Up/Down: speed" << std::endl;
+    }
+    else {
+        std::cout << "Match seed: " << matchSeed << std::endl;
+    }
+
     if (!glfwInit()) {
         std::cout << "Failed to initialize GLFW!" << std::endl;
         return -1;
@@ -235,27 +352,82 @@ int main() {
     // Hide the cursor
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
 
+    // Input only needs timestamping here (for idle mode); it is still polled
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetKeyCallback(window, keyCallback);
+
     if (glewInit() != GLEW_OK) {
         std::cout << "Failed to initialize GLEW!" << std::endl;
         return -1;
     }
 
+    auto setupStart = std::chrono::steady_clock::now();
+    std::cout << "Window and context: " << std::chrono::duration<double, std::milli>(setupStart - startupStart).count() << " ms" << std::endl;
+    programCache.load(PROGRAM_CACHE_PATH);
+    ShaderProgram::setBinaryCache(&programCache);
+    ShaderProgram::setSourcePreloader(&assets);     // Also for programs first built during play
+    setTexturePreloader(&assets);
+
+    // Camera and lighting blocks shared by the 3D shaders; the light never moves
+    SceneUniforms sceneUniforms;
+    sceneUniforms.setLighting(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+
     Background background("barBackground.jpg"); // Load the background texture
     Dartboard dartboard("Dartboard.png", "basic.vert", "basic.frag");
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    TextRenderer textRenderer("Jaro-Regular.ttf", "text.vert", "text.frag", 48);
-    TextRenderer nameRenderer("Jaro-Regular.ttf", "text.vert", "text.frag", 20);
+    FontCache fontCache;
+    Font* hudFont = fontCache.getFont(HUD_FONT_PATH, Font::SDF_SIZE, Font::DISTANCE_FIELD);
+    if (hudFont) hudFont->addGlyphs(assets.takeGlyphs(HUD_FONT_PATH, Font::SDF_SIZE));
+    // Distance field text: one atlas for every size the UI uses
+    TextRenderer textRenderer(fontCache, HUD_FONT_PATH, "text.vert", "text_sdf.frag", 48, Font::DISTANCE_FIELD);
+    HudLabels hud(textRenderer);
     Overlay overlay("overlay.vert", "overlay.frag", "button.vert", "button.frag"); // Initialize the overlay
-    TextRenderer quitRenderer("Jaro-Regular.ttf", "text.vert", "text.frag", 48);
-    TextRenderer arrowRendere("Jaro-Regular.ttf", "text.vert", "text.frag", 48);
 
     crosshair.initialize();  // Initialize the crosshair
     crosshair.setColor(1.0f, 0.0f, 0.0f);  // Start with Player 1's color (Red)
 
     rectangleVAO = createRectangleVAO();
-    rectangleShader = createShaderProgram(vertexShaderSource, fragmentShaderSource);
+    rectangleShader.loadSource(vertexShaderSource, fragmentShaderSource);
+
+    SceneCache sceneCache;
+    sceneCache.initialize();
+
+    setTexturePreloader(nullptr);
+    programCache.save();
+    double setupMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count();
+    std::cout << "Scene setup: " << setupMilliseconds << " ms";
+    if (programCache.isEnabled()) std::cout << " (" << programCache.getHits() << " programs from cache, " << programCache.getMisses() << " compiled)";
+    std::cout << std::endl;
+    assets.printTimings();
+
+    ExpectedScoreMap expectedScoreMap;
+
+    X01Rules houseRules = X01Rules::house();
+    if (!checkoutTable.load(CHECKOUT_TABLE_PATH) || !checkoutTable.matches(houseRules, CHECKOUT_SIGMA)) {
+        std::cout << "Solving checkout table..." << std::endl;
+        checkoutTable.build(houseRules, CHECKOUT_SIGMA);
+        if (checkoutTable.save(CHECKOUT_TABLE_PATH)) checkoutTable.load(CHECKOUT_TABLE_PATH);
+    }
+
+    // Season density layer (H): every throw logged so far, then live throws
+    {
+        ThrowLogReader season;
+        if (season.open(THROW_LOG_PATH)) {
+            for (const ThrowRecord& record : season) dartboard.addDensityHit(record.boardX, record.boardY);
+            std::cout << "Hit density: " << season.size() << " logged throws" << std::endl;
+        }
+    }
+
+    if (!replayMode && !throwLog.open(THROW_LOG_PATH)) {
+        std::cout << "Throws will not be logged" << std::endl;
+    }
+
+    IdleStats idleStats;
+    idleStats.start = glfwGetTime();
+    lastInputTime = idleStats.start;
 
     while (!glfwWindowShouldClose(window)) {
         float currentTime = glfwGetTime();
@@ -273,41 +445,72 @@ int main() {
         }
         lastTime = currentTime;
 
-        // Process input
-        processInput(window);
+        // Feed input to the game and advance it on its fixed timestep, or
+        // advance the replay
+        if (replayMode) {
+            processReplayInput(window, replay, dartboard);
+            replay.update(deltaTime);
+        }
+        else {
+            processInput(window, game, dartboard);
+            game.update(deltaTime);
+        }
+        const Game& shown = replayMode ? replay.getGame() : game;
+        syncScene(shown, dartboard, window);
+
+        if (expectedScoreDirty) {
+            expectedScoreDirty = false;
+            if (showExpectedScore) {
+                auto start = std::chrono::steady_clock::now();
+                const std::vector<float>& expected = expectedScoreMap.compute(throwSigma);
+                dartboard.setExpectedScoreOverlay(expected, expectedScoreMap.getResolution());
+                double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                std::cout << "Expected score map for sigma " << throwSigma << ": " << milliseconds << " ms" << std::endl;
+            }
+            else {
+                dartboard.clearExpectedScoreOverlay();
+            }
+        }
 
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // Create projection and view matrices
-        float fov = 45.0f / currentZoomLevel; // Adjust FOV based on currentZoomLevel
-        glm::mat4 projection = glm::perspective(glm::radians(fov), 800.0f / 800.0f, 0.1f, 100.0f);
-        glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 2.0f / currentZoomLevel); // Move camera closer based on currentZoomLevel
-        glm::mat4 view = glm::lookAt(cameraPos, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        // Camera follows the game's zoom level
+        sceneUniforms.setCamera(shown.getProjection(), shown.getView());
 
-        if (isPaused) {
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-            // Render game objects first
-            background.render(projection, view);
+        // Background and board come from the scene cache unless the camera
+        // or the board's overlays changed since it was drawn
+        if (sceneCache.begin(shown.getProjection(), shown.getView(), dartboard.getBoardVersion())) {
+            background.render();
             checkOpenGLError("Background rendering");
 
-            dartboard.render(projection, view);
+            dartboard.renderBoard();
             checkOpenGLError("Dartboard rendering");
+            sceneCache.end();
+        }
+        sceneCache.draw();
+        checkOpenGLError("Scene cache");
+
+        if (shown.getState().paused) {
+            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+            // Render game objects first
+            dartboard.renderDarts();
+            checkOpenGLError("Dart rendering");
 
             crosshair.render();
             checkOpenGLError("Crosshair rendering");
 
-            // Update the game if not paused
-            updateGame(deltaTime, window, dartboard, textRenderer, projection, view);
+            renderHud(shown, hud);
+            if (replayMode) renderReplayHud(replay, hud);
 
             // Render player's name and details
-            nameRenderer.RenderText("RA 156/2021", 0.0f, 780.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-            nameRenderer.RenderText("Strahinja Galic", 0.0f, 760.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f));
+            hud.studentId.draw();
+            hud.studentName.draw();
 
             // Now render the paused overlay
             overlay.renderPauseMenu();
             checkOpenGLError("Overlay rendering");
 
-            renderRectangle(quitRenderer);
+            renderRectangle(hud.quit);
             checkOpenGLError("Rectangle rendering");
 
             checkQuitClick(window);
@@ -315,29 +518,58 @@ int main() {
         }
         else {
             glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
-            background.render(projection,view);
-            checkOpenGLError("Background rendering");
-
-            dartboard.render(projection, view);
-            checkOpenGLError("Dartboard rendering");
+            dartboard.renderDarts();
+            checkOpenGLError("Dart rendering");
 
             crosshair.render();
             checkOpenGLError("Crosshair rendering");
 
-            // Update the game if not paused
-            updateGame(deltaTime, window, dartboard, textRenderer, projection, view);
+            renderHud(shown, hud);
+            if (replayMode) renderReplayHud(replay, hud);
 
             // Render player's name and details
-            nameRenderer.RenderText("RA 156/2021", 0.0f, 780.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-            nameRenderer.RenderText("Strahinja Galic", 0.0f, 760.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f));
+            hud.studentId.draw();
+            hud.studentName.draw();
         }
 
         // Swap buffers and poll events
         glfwSwapBuffers(window);
         glfwPollEvents();
+
+        if (firstFrame) {
+            firstFrame = false;
+            std::cout << "First frame: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupStart).count() << " ms after start" << std::endl;
+        }
+        ++idleStats.frames;
+
+        // Nothing will change until an event arrives, or the game's timer
+        // (the turn clearing) runs out: wait for that instead of redrawing
+        if (idleMode && sceneIsIdle(shown, replay)) {
+            double idleStart = glfwGetTime();
+            float timer = replayMode ? -1.0f : game.getTimerSeconds();
+            if (timer > 0.0f) {
+                glfwWaitEventsTimeout(std::min(timer, IDLE_TIMER_SLICE));
+            }
+            else {
+                glfwWaitEvents();
+                lastTime = (float)glfwGetTime();    // Time spent waiting is not game time
+            }
+            idleStats.idle += glfwGetTime() - idleStart;
+            ++idleStats.wakeups;
+        }
+
+        double now = glfwGetTime();
+        if (now - idleStats.start >= IDLE_REPORT_SECONDS) {
+            printIdleStats(idleStats, now);
+            idleStats = IdleStats();
+            idleStats.start = now;
+        }
     }
+    printIdleStats(idleStats, glfwGetTime());
 
     // Cleanup and exit
+    throwLog.close();
+    programCache.save();    // Programs first built during play (E, H)
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
@@ -348,155 +580,187 @@ int main() {
 
 
 
-void processInput(GLFWwindow* window) {
-    static bool escPressed = false;
+void processInput(GLFWwindow* window, Game& game, Dartboard& dartboard) {
+    GameInput input;
 
-    // Toggle pause menu with ESC
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS && !escPressed) {
-        escPressed = true;
-        isPaused = !isPaused;
-    }
-
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_RELEASE) {
-        escPressed = false;
-    }
-
-    // Only process crosshair movement if the game is not paused
-    if (!isPaused) {
-        double mouseX, mouseY;
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-
-        int width, height;
-        glfwGetWindowSize(window, &width, &height);
-
-        float normX = (mouseX / width) * 2.0f - 1.0f;  // X coordinate in NDC
-        float normY = 1.0f - (mouseY / height) * 2.0f; // Y coordinate in NDC
-
-        // Make shaking more intense only when exactly zoomed in
-        const float ZOOMED_IN_LEVEL = 1.1f;
-        const float ZOOM_EPSILON = 0.01f;
-        float shakeAmount = (fabs(currentZoomLevel - ZOOMED_IN_LEVEL) < ZOOM_EPSILON) ? 0.06f : 0.02f;
-        float shakeX = ((rand() % 1000 - 500) / 500.0f) * shakeAmount;
-        float shakeY = ((rand() % 1000 - 500) / 500.0f) * shakeAmount;
+    double mouseX, mouseY;
+    glfwGetCursorPos(window, &mouseX, &mouseY);
 
-        crosshair.setPosition(normX + shakeX, normY + shakeY);
-    }
+    int width, height;
+    glfwGetWindowSize(window, &width, &height);
 
-    // Handle zooming
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
-        targetZoomLevel -= 0.1f;
-        if (targetZoomLevel < 0.1f) targetZoomLevel = 0.1f; // Prevent zooming too far in
+    input.aimX = (mouseX / width) * 2.0f - 1.0f;  // X coordinate in NDC
+    input.aimY = 1.0f - (mouseY / height) * 2.0f; // Y coordinate in NDC
+    input.throwHeld = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+    input.pauseHeld = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
+    input.steadyHeld = glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS;
+    input.zoomInHeld = glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS;
+    input.zoomOutHeld = glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS;
+    game.handleInput(input);
+
+    // Expected-score overlay
+    static bool overlayKeyPressed = false;
+    static bool sigmaKeyPressed = false;
+    bool overlayKey = glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS;
+    if (overlayKey && !overlayKeyPressed) {
+        showExpectedScore = !showExpectedScore;
+        expectedScoreDirty = true;
     }
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-        targetZoomLevel += 0.1f;
-        if (targetZoomLevel > 2.0f) targetZoomLevel = 2.0f; // Prevent zooming too far out
+    overlayKeyPressed = overlayKey;
+
+    bool narrower = glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS;
+    bool wider = glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS;
+    if ((narrower || wider) && !sigmaKeyPressed) {
+        throwSigma *= wider ? 1.25f : 0.8f;
+        if (throwSigma < MIN_THROW_SIGMA) throwSigma = MIN_THROW_SIGMA;
+        if (throwSigma > MAX_THROW_SIGMA) throwSigma = MAX_THROW_SIGMA;
+        expectedScoreDirty = showExpectedScore;
     }
+    sigmaKeyPressed = narrower || wider;
 
-    // Handle zooming with Alt key
-    if (glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS) {
-        currentZoomLevel = 1.1f; // Instantly zoom in
-        std::cout << "Alt key pressed: Zooming in" << std::endl; // Debug output
-    }
-    else {
-        currentZoomLevel = targetZoomLevel; // Reset zoom to target zoom level
-    }
+    if (keyPressedOnce(window, GLFW_KEY_H)) dartboard.setHitDensityVisible(!dartboard.isHitDensityVisible());
 }
 
+// True only on the frame a key goes down
+bool keyPressedOnce(GLFWwindow* window, int key) {
+    static bool wasDown[GLFW_KEY_LAST + 1] = {};
+    bool down = glfwGetKey(window, key) == GLFW_PRESS;
+    bool pressed = down && !wasDown[key];
+    wasDown[key] = down;
+    return pressed;
+}
 
+void processReplayInput(GLFWwindow* window, ReplayEngine& replay, Dartboard& dartboard) {
+    if (keyPressedOnce(window, GLFW_KEY_H)) dartboard.setHitDensityVisible(!dartboard.isHitDensityVisible());
+    if (keyPressedOnce(window, GLFW_KEY_SPACE)) replay.setPlaying(!replay.isPlaying());
+    if (keyPressedOnce(window, GLFW_KEY_UP)) replay.setSpeed(replay.getSpeed() * 10.0f);
+    if (keyPressedOnce(window, GLFW_KEY_DOWN)) replay.setSpeed(replay.getSpeed() / 10.0f);
+
+    // Turn jumps go through the keyframe index, so any distance is instant
+    long turn = (long)replay.getTurn();
+    long target = turn;
+    if (keyPressedOnce(window, GLFW_KEY_RIGHT)) target += 1;
+    if (keyPressedOnce(window, GLFW_KEY_LEFT)) target -= 1;
+    if (keyPressedOnce(window, GLFW_KEY_PAGE_UP)) target += 10;
+    if (keyPressedOnce(window, GLFW_KEY_PAGE_DOWN)) target -= 10;
+    if (keyPressedOnce(window, GLFW_KEY_HOME)) target = 0;
+    if (keyPressedOnce(window, GLFW_KEY_END)) target = (long)replay.getTurnCount() - 1;
+    if (target != turn) {
+        replay.seekTurn(target < 0 ? 0 : (std::size_t)target);
+        resyncScene(dartboard);
+    }
+}
 
 
 
 
 
-void updateGame(float deltaTime, GLFWwindow* window, Dartboard& dartboard, TextRenderer& textRenderer, const glm::mat4& projection, const glm::mat4& view) {
-    static bool waitingToClear = false;
-    static float clearStartTime = 0.0f;
-
-    Player& current = (currentPlayer == 0) ? player1 : player2;
 
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !throwProcessed && !isPaused) {
-        if (current.getDartsLeft() > 0) {
-            processThrow(current, dartboard, projection, view);
-            throwProcessed = true;
 
-            if (current.getScore() == 501) {
-                std::cout << current.getName() << " wins with a perfect 501!" << std::endl;
-                glfwSetWindowShouldClose(window, true); // Close the window to end the game
-            }
-            else if (current.getDartsLeft() == 0 && !waitingToClear) {
-                waitingToClear = true;
-                clearStartTime = glfwGetTime();
-            }
-        }
-        else {
-            std::cout << current.getName() << " has no darts left!" << std::endl;
-        }
-    }
+// Bring the crosshair and the darts on the board in line with the game
+void syncScene(const Game& game, Dartboard& dartboard, GLFWwindow* window) {
+    const GameState& state = game.getState();
 
-    if (waitingToClear) {
-        float elapsedTime = glfwGetTime() - clearStartTime;
-        if (elapsedTime >= 1.0f) {
-            dartboard.clearHits();
-            currentPlayer = (currentPlayer == 0) ? 1 : 0;
-            (currentPlayer == 0 ? player1 : player2).resetDarts();
-            waitingToClear = false;
+    crosshair.setPosition(state.crosshairX, state.crosshairY);
 
-            crosshair.setColor((currentPlayer == 0) ? 1.0f : 0.0f, 0.0f, (currentPlayer == 1) ? 1.0f : 0.0f);
-            std::cout << "Switching to " << (currentPlayer == 0 ? player1.getName() : player2.getName()) << std::endl;
+    if (state.throwCount != sceneSync.throwCount) {
+        sceneSync.throwCount = state.throwCount;
+        const ThrowState& hit = state.lastThrow;
+        if (!replayMode) {
+            throwLog.append(hit);
+            dartboard.addDensityHit(hit.boardX, hit.boardY);
+            std::cout << game.getPlayerName(hit.player) << " hit (" << hit.boardX << ", " << hit.boardY
+                      << ") and scored " << hit.score << " points!\n";
+            std::cout << "Crosshair NDC: (" << hit.crosshairX << ", " << hit.crosshairY << ")\n";
         }
     }
 
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_RELEASE) {
-        throwProcessed = false;
+    // A fast replay can cross a turn boundary within one frame, so a new turn
+    // is told by its round and player rather than by the dart count dropping
+    bool newTurn = state.roundNumber != sceneSync.roundNumber || state.activePlayer != sceneSync.activePlayer;
+    if (newTurn || state.dartCount < sceneSync.dartCount) {
+        dartboard.clearHits();
+        sceneSync.dartCount = 0;
+        sceneSync.roundNumber = state.roundNumber;
+    }
+    while (sceneSync.dartCount < state.dartCount) {
+        dartboard.recordHit(state.dartX[sceneSync.dartCount], state.dartY[sceneSync.dartCount]);
+        ++sceneSync.dartCount;
     }
 
-    crosshair.update(deltaTime);
-    std::string text = current.getName() + ": " + std::to_string(current.getScore());
-    textRenderer.RenderText(text, 0.0f, 30.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f));
-    checkOpenGLError("Rendering player name text");
+    if (state.activePlayer != sceneSync.activePlayer) {
+        sceneSync.activePlayer = state.activePlayer;
+        throwLog.flush();
+        crosshair.setColor((state.activePlayer == 0) ? 1.0f : 0.0f, 0.0f, (state.activePlayer == 1) ? 1.0f : 0.0f);
+        std::cout << "Switching to " << game.getPlayerName(state.activePlayer) << std::endl;
+    }
 
-    // Display number of darts left
-    std::string dartsLeftText = "Darts left: " + std::to_string(current.getDartsLeft());
-    textRenderer.RenderText(dartsLeftText, -0.9f, 0.8f, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
+    if (state.phase == GameState::FINISHED && !sceneSync.finished) {
+        sceneSync.finished = true;
+        throwLog.flush();
+        std::cout << game.getPlayerName(state.winner) << " wins with a perfect " << game.getRules().startScore << "!" << std::endl;
+        if (!replayMode) glfwSetWindowShouldClose(window, true); // Close the window to end the game
+    }
 }
 
+// Forget what the scene shows so the next syncScene redraws it from scratch
+void resyncScene(Dartboard& dartboard) {
+    dartboard.clearHits();
+    sceneSync = SceneSync();
+    sceneSync.activePlayer = -1;
+}
 
-void processThrow(Player& currentPlayer, Dartboard& dartboard, const glm::mat4& projection, const glm::mat4& view) {
-    // Get crosshair NDC position
-    float hitX = crosshair.getX();
-    float hitY = crosshair.getY();
+void renderReplayHud(const ReplayEngine& replay, HudLabels& hud) {
+    hud.replay.begin();
+    hud.replay.append("Replay  turn ");
+    hud.replay.append((long long)replay.getTurn() + 1);
+    hud.replay.append("/");
+    hud.replay.append((long long)replay.getTurnCount());
+    hud.replay.append("  x");
+    hud.replay.append(replay.getSpeed(), -1);
+    hud.replay.append(replay.isPlaying() ? "" : "  (paused)");
+    hud.replay.end();
+    hud.replay.draw();
+}
 
-    // Window size (update if your window size is not 800x800)
-    int width = 800, height = 800;
+void renderHud(const Game& game, HudLabels& hud) {
+    const GameState& state = game.getState();
+    const PlayerState& current = state.players[state.activePlayer];
 
-    // Convert NDC [-1,1] to window coordinates
-    float winX = (hitX * 0.5f + 0.5f) * width;
-    float winY = (hitY * 0.5f + 0.5f) * height;
+    hud.score.begin();
+    hud.score.append(game.getPlayerName(state.activePlayer));
+    hud.score.append(": ");
+    hud.score.append((long long)current.score);
+    hud.score.end();
+    hud.score.draw();
+    checkOpenGLError("Rendering player name text");
 
-    // Dartboard is at z = 0.1f in world space
-    float boardZ = 0.1f;
+    // Display number of darts left
+    hud.dartsLeft.begin();
+    hud.dartsLeft.append("Darts left: ");
+    hud.dartsLeft.append((long long)current.dartsLeft);
+    hud.dartsLeft.end();
+    hud.dartsLeft.draw();
+
+    // Aim hint from the precomputed checkout table
+    int startScore = game.getRules().startScore;
+    CheckoutHint hint = checkoutTable.lookup(startScore - current.score, current.dartsLeft, startScore - current.turnStartScore);
+    if (hint.isValid() && checkoutTable.matches(game.getRules(), CHECKOUT_SIGMA)) {
+        hud.hint.begin();
+        hud.hint.append("Aim: ");
+        hud.hint.append(CheckoutTable::targetName(hint.target));
+        hud.hint.append(" (");
+        hud.hint.append((double)hint.expectedDarts, 1);
+        hud.hint.append(" darts to finish)");
+        hud.hint.end();
+        hud.hint.draw();
+    }
+}
 
-    // Unproject: get world coordinates at near and far plane
-    glm::vec4 viewport(0, 0, width, height);
-    glm::vec3 nearPoint = glm::unProject(glm::vec3(winX, winY, 0.0f), view, projection, viewport);
-    glm::vec3 farPoint  = glm::unProject(glm::vec3(winX, winY, 1.0f), view, projection, viewport);
 
-    // Interpolate to the dartboard's z
-    float t = (boardZ - nearPoint.z) / (farPoint.z - nearPoint.z);
-    glm::vec3 worldPos = nearPoint + t * (farPoint - nearPoint);
 
-    // Record the hit at the computed world position
-    dartboard.recordHit(worldPos.x, worldPos.y);
-    int points = dartboard.calculateScore(worldPos.x, worldPos.y, currentZoomLevel);
 
-    std::cout << currentPlayer.getName() << " hit (" << worldPos.x << ", " << worldPos.y
-              << ") and scored " << points << " points!\n";
-    std::cout << "Crosshair NDC: (" << hitX << ", " << hitY << ")\n";
-    std::cout << "Dartboard coords: (" << worldPos.x << ", " << worldPos.y << ")\n";
 
-    currentPlayer.addScore(points);
-    currentPlayer.throwDart();
-}
 
 
 
@@ -505,10 +769,32 @@ void processThrow(Player& currentPlayer, Dartboard& dartboard, const glm::mat4&
 
 
 
+// Nothing on screen moves by itself: the game is paused, the player has
+// been away for IDLE_AFTER_SECONDS (the crosshair shake stops), or the
+// replay is paused or over
+bool sceneIsIdle(const Game& shown, const ReplayEngine& replay) {
+    if (replayMode) return !replay.isPlaying() || replay.getPosition() >= replay.getThrowCount();
+    return shown.getState().paused || glfwGetTime() - lastInputTime >= IDLE_AFTER_SECONDS;
+}
 
+void cursorPosCallback(GLFWwindow*, double, double) {
+    lastInputTime = glfwGetTime();
+}
 
+void mouseButtonCallback(GLFWwindow*, int, int, int) {
+    lastInputTime = glfwGetTime();
+}
 
+void keyCallback(GLFWwindow*, int, int, int, int) {
+    lastInputTime = glfwGetTime();
+}
 
+void printIdleStats(const IdleStats& stats, double now) {
+    double elapsed = now - stats.start;
+    if (elapsed <= 0.0) return;
+    std::cout << "Idle: " << 100.0 * stats.idle / elapsed << "% of the last " << elapsed << " s ("
+              << stats.frames << " frames, " << stats.wakeups << " wakeups)" << std::endl;
+}
 
 void checkOpenGLError(const char* description) {
     GLenum err;
@@ -0,0 +1,15 @@
+#version 330 core
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D text;
+uniform vec3 textColor;
+
+void main() {
+    // Distance field: 0.5 on the outline. Antialias over one screen pixel,
+    // whatever size the text is drawn at.
+    float distance = texture(text, TexCoords).r;
+    float width = fwidth(distance);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    color = vec4(textColor, alpha);
+}
@@ -0,0 +1,73 @@
+// Bakes images into .dtex textures the game loads without decoding: the
+// full mip chain, optionally DXT-compressed (DXT1 for RGB, DXT5 for RGBA).
+// Each input is written next to itself, e.g. Dartboard.png -> Dartboard.dtex.
+//
+//   BakeTextures [--compress] Dartboard.png barBackground.jpg dart.png
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../stb_image.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "../TextureFile.h"
+
+static std::string bakedPath(const std::string& imagePath) {
+    std::string::size_type dot = imagePath.find_last_of('.');
+    std::string::size_type slash = imagePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return imagePath + ".dtex";
+    return imagePath.substr(0, dot) + ".dtex";
+}
+
+int main(int argc, char** argv) {
+    bool compress = false;
+    int baked = 0, failed = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--compress") == 0) {
+            compress = true;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        TextureImage image;
+        int channels;
+        unsigned char* data = stbi_load(argv[i], &image.width, &image.height, &channels, 0);
+        if (!data) {
+            std::cerr << "Could not load " << argv[i] << ": " << stbi_failure_reason() << std::endl;
+            ++failed;
+            continue;
+        }
+        // Grey and grey-alpha images are widened to RGB/RGBA
+        if (channels < 3) {
+            stbi_image_free(data);
+            channels += 2;
+            data = stbi_load(argv[i], &image.width, &image.height, nullptr, channels);
+            if (!data) {
+                ++failed;
+                continue;
+            }
+        }
+        image.channels = channels;
+        image.pixels.assign(data, data + (std::size_t)image.width * image.height * channels);
+        stbi_image_free(data);
+
+        std::vector<TextureImage> levels = buildMipChain(std::move(image));
+        std::string output = bakedPath(argv[i]);
+        if (!writeTextureFile(output.c_str(), levels, compress)) {
+            ++failed;
+            continue;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << argv[i] << " -> " << output << ": " << levels[0].width << "x" << levels[0].height
+            << ", " << levels.size() << " levels, " << (compress ? (channels == 4 ? "DXT5" : "DXT1") : (channels == 4 ? "RGBA8" : "RGB8"))
+            << " (" << ms << " ms)" << std::endl;
+        ++baked;
+    }
+
+    if (baked + failed == 0) {
+        std::cerr << "Usage: BakeTextures [--compress] image..." << std::endl;
+        return 1;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,39 @@
+// Bundles asset files into one archive (assets.pak) the game maps at
+// startup instead of opening each file. Fails, writing nothing, if any file
+// is missing, so a broken deploy shows up here rather than on the kiosk.
+//
+//   PackAssets assets.pak basic.vert basic.frag ... Jaro-Regular.ttf Dartboard.png
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../AssetPack.h"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: PackAssets output.pak file..." << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> files(argv + 2, argv + argc);
+    if (!writeAssetPack(argv[1], files)) {
+        std::cerr << "Could not write " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Read it back: every file must be found under the name it was packed as
+    AssetPack pack;
+    if (!pack.open(argv[1])) return 1;
+    for (const std::string& file : files) {
+        AssetView view;
+        if (!pack.find(file, view)) {
+            std::cerr << "Packed file not found: " << file << std::endl;
+            return 1;
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << argv[1] << ": " << pack.getFileCount() << " files (" << ms << " ms)" << std::endl;
+    return 0;
+}
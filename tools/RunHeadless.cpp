@@ -0,0 +1,11 @@
+// Runs the game loop with scripted input and no window, as fast as the CPU
+// allows, and prints ticks/s and throws/s. Same options as `Sablon --headless`.
+//
+//   RunHeadless [--seed S] [--matches N] [--script FILE] [--max-ticks T]
+//               [--double-out] [--log FILE]
+
+#include "../HeadlessRunner.h"
+
+int main(int argc, char** argv) {
+    return runHeadless(argc, argv);
+}
@@ -0,0 +1,40 @@
+// Plays simulated 501 legs between two throwers and prints win rates.
+//
+//   SimulateMatches [--legs N] [--seed S] [--threads T] [--double-out]
+//                   [--sigma A] [--sigma B]
+//
+// Sigma is the throw error in board units (the board radius is 0.4); the
+// first --sigma sets player 1, the second player 2.
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "../MatchSimulator.h"
+
+int main(int argc, char** argv) {
+    unsigned long long legs = 1000000;
+    unsigned long long seed = 1;
+    unsigned threads = 0;
+    float sigmas[2] = { 0.015f, 0.02f };
+    int sigmaCount = 0;
+    X01Rules rules = X01Rules::house();
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--legs") && hasValue) legs = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threads") && hasValue) threads = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--sigma") && hasValue && sigmaCount < 2) sigmas[sigmaCount++] = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--double-out")) rules = X01Rules::tournament();
+        else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Solving checkout tables..." << std::endl;
+    MatchSimulator simulator({ "Player 1", sigmas[0] }, { "Player 2", sigmas[1] }, rules);
+    MatchReport report = simulator.run(legs, seed, threads);
+    simulator.printReport(report);
+    return 0;
+}
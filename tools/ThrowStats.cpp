@@ -0,0 +1,53 @@
+// Summarises a binary throw log (throws.dtl) per player: darts thrown,
+// average score per dart, misses, busts and finishes.
+//
+//   ThrowStats [throws.dtl]
+
+#include <chrono>
+#include <iostream>
+#include "../ThrowLog.h"
+#include "../X01Rules.h"
+
+struct PlayerStats {
+    unsigned long long darts = 0;
+    unsigned long long points = 0;
+    unsigned long long misses = 0;
+    unsigned long long busts = 0;
+    unsigned long long finishes = 0;
+};
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "throws.dtl";
+
+    auto start = std::chrono::steady_clock::now();
+    ThrowLogReader log;
+    if (!log.open(path)) {
+        std::cerr << "Could not read throw log: " << path << std::endl;
+        return 1;
+    }
+
+    PlayerStats players[2];
+    std::int64_t first = 0, last = 0;
+    for (const ThrowRecord& record : log) {
+        if (!first) first = record.timestamp;
+        last = record.timestamp;
+
+        PlayerStats& stats = players[record.player & 1];
+        ++stats.darts;
+        stats.points += record.score;
+        if (record.score == 0) ++stats.misses;
+        if (record.result == X01Rules::BUST) ++stats.busts;
+        if (record.result == X01Rules::FINISHED) ++stats.finishes;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << log.size() << " throws over " << (last - first) / 3600000000.0 << " hours (read in "
+        << seconds * 1000.0 << " ms)" << std::endl;
+    for (int player = 0; player < 2; ++player) {
+        const PlayerStats& stats = players[player];
+        std::cout << "  Player " << player + 1 << ": " << stats.darts << " darts, "
+            << (stats.darts ? (double)stats.points / stats.darts : 0.0) << " points per dart, "
+            << stats.misses << " misses, " << stats.busts << " busts, " << stats.finishes << " finishes" << std::endl;
+    }
+    return 0;
+}